@@ -0,0 +1,29 @@
+#ifndef _APP_BENCH_CFG_H_
+#define _APP_BENCH_CFG_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_BENCH_START_DELAY           (2000U)     /* ms - sensors configured, system settled */
+#define APP_BENCH_PROBE_TIMEOUT         (60000U)    /* ms - incomplete probes are reported with the passes so far */
+#define APP_BENCH_POLL_PERIOD           (100U)      /* ms - probe completion and UART retry period */
+#define APP_BENCH_NAME_MAX_LEN          (32U)       /* Max length of the benchmark name */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _APP_BENCH_CFG_H_ */
@@ -0,0 +1,304 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdio.h>
+#include "app_bench.h"
+#include "app_bench_cfg.h"
+#include "app_format.h"
+#include "hal_energy_monitor.h"
+#include "hal_energy_monitor_cfg.h"
+#include "ina226.h"
+#include "dwt.h"
+#include "hal_uart.h"
+#include "hal_uart_cfg.h"
+#include "cmsis_os.h"
+#include "stm32f7xx.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_BENCH_SIGNAL                (0x01)      /* Context switch partner wake-up */
+
+/* BENCH,name,samples,min,median,max\r\n */
+#define APP_BENCH_LINE_LEN              (App_Format_LiteralLen("BENCH_BEGIN,,,\r\n") + APP_BENCH_NAME_MAX_LEN + \
+                                         (4U * APP_FORMAT_UNSIGNED_32B_MAX_LEN))
+#define APP_BENCH_REPORT_LEN            (APP_BENCH_LINE_LEN * (Bench_Max + 2U))
+
+#define APP_BENCH_SNPRINTF_LINE_LEN     (192U)
+
+#define BENCH_CFG_BENCHMARK(id, name, function) _Static_assert(App_Format_LiteralLen(name) <= APP_BENCH_NAME_MAX_LEN, \
+                                                               #id " name is longer than APP_BENCH_NAME_MAX_LEN");
+#define BENCH_CFG_PROBE(id, name)               _Static_assert(App_Format_LiteralLen(name) <= APP_BENCH_NAME_MAX_LEN, \
+                                                               #id " name is longer than APP_BENCH_NAME_MAX_LEN");
+    BENCH_CFG_TABLE
+#undef BENCH_CFG_BENCHMARK
+#undef BENCH_CFG_PROBE
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/* Values converted by the float reference */
+typedef struct
+{
+    float bus_voltage;          /* V */
+    float current;              /* mA */
+    float power;                /* mW */
+    uint64_t timestamp;         /* ns */
+}App_Bench_FloatData_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void App_Bench_Task(void const * argument);
+static void App_Bench_SwitchTask(void const * argument);
+static void App_Bench_WaitProbes(void);
+static void App_Bench_Report(void);
+static uint32_t App_Bench_FormatLine(char* line, const Bench_Result_t* result);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static osThreadId App_Bench_TaskHandle;
+static osThreadId App_Bench_SwitchTaskHandle;
+static Hal_EnergyMonitor_Data_t App_Bench_Data;         /* Values formatted by the snprintf reference */
+static volatile App_Bench_FloatData_t App_Bench_FloatSink;  /* Keeps the float reference conversion */
+static char App_Bench_Buffer[APP_BENCH_REPORT_LEN];
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP benchmark initialization function
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Bench_Init(void)
+{
+    /* Create threads - the partner preempts the benchmark task, which preempts the application */
+    osThreadDef(App_BenchSwitch, App_Bench_SwitchTask, osPriorityRealtime, 0, 128);
+    App_Bench_SwitchTaskHandle = osThreadCreate(osThread(App_BenchSwitch), NULL);
+
+    osThreadDef(App_Bench, App_Bench_Task, osPriorityHigh, 0, 512);
+    App_Bench_TaskHandle = osThreadCreate(osThread(App_Bench), NULL);
+}
+
+/*!	
+ * \brief Benchmark without code - overhead of the measurement
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Bench_Empty(void)
+{
+}
+
+/*!	
+ * \brief Benchmark of the task switch - the signal wakes the higher priority partner, which waits
+ *        again, so two switches are measured
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Bench_ContextSwitch(void)
+{
+    (void)osSignalSet(App_Bench_SwitchTaskHandle, APP_BENCH_SIGNAL);
+}
+
+/*!	
+ * \brief Benchmark of the log line formatted with snprintf - reference for app_format_line
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Bench_SnprintfLine(void)
+{
+    static char line[APP_BENCH_SNPRINTF_LINE_LEN];
+    const Hal_EnergyMonitor_Data_t* data = &App_Bench_Data;
+    uint32_t time_us = (uint32_t)(data->timestamp / 1000U);
+
+    (void)snprintf(line, sizeof(line), "%02u::%02u::%02u.%06u CH%u U= %.2f[V] I=%.2f (%.2f..%.2f, RMS %.2f) [mA] "
+                   "P=%.2f (max %.2f) [mW] Consumption=%.2f [mWh] Charge=%.3f [mAh] Alert:%u\r\n",
+                   (unsigned int)(time_us / 3600000000U), (unsigned int)((time_us / 60000000U) % 60U),
+                   (unsigned int)((time_us / 1000000U) % 60U), (unsigned int)(time_us % 1000000U), 0U,
+                   data->bus_voltage / 1e6, data->current / 1e3, data->current / 1e3, data->current / 1e3,
+                   data->current / 1e3, data->power / 1e3, data->power / 1e3, data->power / 1e3,
+                   data->current / 1e3, 0U);
+}
+
+/*!	
+ * \brief Benchmark of the register set converted in float - reference for hal_convert
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Bench_ConvertFloat(void)
+{
+    App_Bench_FloatData_t data;
+    INA226_Results_t results;
+
+    (void)INA226_GetResults((INA226_Channel_t)0, &results);
+
+    data.bus_voltage = (float)results.bus_voltage * (HAL_ENERGY_MONITOR_BUS_VOLTAGE_LSB_UV / 1000000.0f);
+#if (HAL_ENERGY_MONITOR_SHUNT_MODE == 1U)
+    data.current = (float)(int16_t)results.shunt_voltage * (HAL_ENERGY_MONITOR_SHUNT_VOLTAGE_LSB_NV / 1000.0f) / \
+                   (float)HAL_ENERGY_MONITOR_SHUNT_RESISTANCE_MOHM;
+    data.power = data.bus_voltage * data.current;
+#else
+    data.current = (float)(int16_t)results.current * (HAL_ENERGY_MONITOR_CURRENT_LSB_NA / 1000000.0f);
+    data.power = (float)results.power * (HAL_ENERGY_MONITOR_POWER_LSB_NW / 1000000.0f);
+#endif
+    data.timestamp = Dwt_CyclesToNs(results.timestamp);
+    App_Bench_FloatSink = data;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP benchmark task - runs once
+ *
+ * \param[in] argument OS required parameter
+ * 
+ * \retval None
+ */
+static void App_Bench_Task(void const * argument)
+{
+    osDelay(APP_BENCH_START_DELAY);
+
+    Hal_EnergyMonitor_GetResults(0U, &App_Bench_Data);
+
+    for(uint32_t i = 0U; i < Bench_Max; i++)
+    {
+        Bench_Run((Bench_Id_t)i);
+    }
+
+    App_Bench_WaitProbes();
+    App_Bench_Report();
+
+    while(1)
+    {
+        osDelay(osWaitForever);
+    }
+}
+
+/*!	
+ * \brief Context switch partner - returns to the benchmark task at once
+ *
+ * \param[in] argument OS required parameter
+ * 
+ * \retval None
+ */
+static void App_Bench_SwitchTask(void const * argument)
+{
+    while(1)
+    {
+        (void)osSignalWait(APP_BENCH_SIGNAL, osWaitForever);
+    }
+}
+
+/*!	
+ * \brief Wait until all probes are complete or APP_BENCH_PROBE_TIMEOUT elapses
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_Bench_WaitProbes(void)
+{
+    uint32_t time = 0U;
+    bool complete = false;
+
+    while((!complete) && (time < APP_BENCH_PROBE_TIMEOUT))
+    {
+        complete = true;
+
+        for(uint32_t i = 0U; i < Bench_Max; i++)
+        {
+            complete = complete && Bench_IsComplete((Bench_Id_t)i);
+        }
+
+        if(!complete)
+        {
+            osDelay(APP_BENCH_POLL_PERIOD);
+            time += APP_BENCH_POLL_PERIOD;
+        }
+    }
+}
+
+/*!	
+ * \brief Transmit the results - one write, retried until it fits in the UART buffer
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_Bench_Report(void)
+{
+    Bench_Result_t result;
+    uint32_t len = 0U;
+
+    len += App_Format_String(&App_Bench_Buffer[len], "BENCH_BEGIN,");
+    len += App_Format_Unsigned(&App_Bench_Buffer[len], SystemCoreClock, 1U);
+    len += App_Format_String(&App_Bench_Buffer[len], ",");
+    len += App_Format_Unsigned(&App_Bench_Buffer[len], BENCH_WARMUP, 1U);
+    len += App_Format_String(&App_Bench_Buffer[len], ",");
+    len += App_Format_Unsigned(&App_Bench_Buffer[len], BENCH_REPETITIONS, 1U);
+    len += App_Format_String(&App_Bench_Buffer[len], "\r\n");
+
+    for(uint32_t i = 0U; i < Bench_Max; i++)
+    {
+        Bench_GetResult((Bench_Id_t)i, &result);
+        len += App_Bench_FormatLine(&App_Bench_Buffer[len], &result);
+    }
+
+    len += App_Format_String(&App_Bench_Buffer[len], "BENCH_END\r\n");
+
+    while(Hal_Uart_Write((const uint8_t*)App_Bench_Buffer, (uint16_t)len) != HAL_UART_CODE_OK)
+    {
+        osDelay(APP_BENCH_POLL_PERIOD);
+    }
+}
+
+/*!	
+ * \brief The function formats one result line - the length never exceeds APP_BENCH_LINE_LEN
+ *
+ * \param[out] line Output position
+ * \param[in] result Benchmark result
+ * 
+ * \retval Line length
+ */
+static uint32_t App_Bench_FormatLine(char* line, const Bench_Result_t* result)
+{
+    uint32_t len = 0U;
+
+    len += App_Format_String(&line[len], "BENCH,");
+    len += App_Format_String(&line[len], result->name);
+    len += App_Format_String(&line[len], ",");
+    len += App_Format_Unsigned(&line[len], result->samples, 1U);
+    len += App_Format_String(&line[len], ",");
+    len += App_Format_Unsigned(&line[len], result->min, 1U);
+    len += App_Format_String(&line[len], ",");
+    len += App_Format_Unsigned(&line[len], result->median, 1U);
+    len += App_Format_String(&line[len], ",");
+    len += App_Format_Unsigned(&line[len], result->max, 1U);
+    len += App_Format_String(&line[len], "\r\n");
+
+    return len;
+}
@@ -0,0 +1,47 @@
+#ifndef _APP_BENCH_H_
+#define _APP_BENCH_H_
+
+/* 
+ * Benchmark task of the BENCH_ENABLE build - runs the benchmarks of BENCH_CFG_TABLE once, waits for
+ * the probes and reports the cycles over USART3, one CSV line per benchmark:
+ *
+ *   BENCH_BEGIN,<core clock Hz>,<warm-up>,<repetitions>
+ *   BENCH,<name>,<samples>,<min>,<median>,<max>
+ *   BENCH_END
+ *
+ * The lines are interleaved with the regular log, Tools/bench_compare.py compares two captures.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "bench.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+void App_Bench_Init(void);
+
+/*
+ * Benchmarks
+ */
+void App_Bench_Empty(void);
+void App_Bench_ContextSwitch(void);
+void App_Bench_SnprintfLine(void);
+void App_Bench_ConvertFloat(void);
+
+#endif  /* _APP_BENCH_H_ */
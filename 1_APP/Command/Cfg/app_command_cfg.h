@@ -0,0 +1,46 @@
+#ifndef _APP_COMMAND_CFG_H_
+#define _APP_COMMAND_CFG_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_COMMAND_THREAD_PERIOD       (20U)   /* ms - received data polling period */
+#define APP_COMMAND_LINE_LEN            (32U)   /* Max command line length with '\0', longer lines are rejected */
+#define APP_COMMAND_DUMP_BATCH          (16U)   /* Samples sent at once by the dump command */
+#define APP_COMMAND_TRACE_TASKS         (16U)   /* Max tasks named in the trace dump */
+
+/*
+ * Commands: name, handler. A command is one text line - the name, optionally followed by a space and
+ * an argument, terminated by CR or LF. Every command is answered in the log.
+ *
+ * period <ms>    - acquisition period, in conversion ready mode rounded down to the sensor averaging
+ * format <0..2>  - log format, see App_EnergyMonitor_Format_t
+ * dump           - send the sample history as binary records
+ * trace          - send the trace buffer (context switches, interrupts) as binary frames
+ * reset          - reset energy and charge counters
+ */
+#define APP_COMMAND_TABLE  \
+    APP_COMMAND("period",   App_Command_Period)     \
+    APP_COMMAND("format",   App_Command_Format)     \
+    APP_COMMAND("dump",     App_Command_Dump)       \
+    APP_COMMAND("trace",    App_Command_Trace)      \
+    APP_COMMAND("reset",    App_Command_Reset)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _APP_COMMAND_CFG_H_ */
@@ -0,0 +1,422 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <string.h>
+#include "app_command.h"
+#include "app_command_cfg.h"
+#include "app_energy_monitor.h"
+#include "app_telemetry.h"
+#include "hal_energy_monitor.h"
+#include "hal_uart.h"
+#include "hal_gpio.h"
+#include "hal_uart_cfg.h"
+#include "log.h"
+#include "trace.h"
+#include "cmsis_os.h"
+#include "stm32f7xx.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_COMMAND_CODE_OK             (0U)
+#define APP_COMMAND_CODE_NOT_OK         (1U)
+
+#define APP_COMMAND_RX_LEN              (32U)   /* Bytes read from the UART at once */
+
+_Static_assert((APP_COMMAND_DUMP_BATCH * APP_TELEMETRY_FRAME_MAX_LEN) > APP_TELEMETRY_TRACE_FRAME_MAX_LEN, \
+               "Trace frame does not fit in the dump buffer");
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Command handler - argument is the rest of the line after the name, empty if none
+ */
+typedef uint8_t (*App_Command_Handler_t)(const char* arg);
+
+typedef struct
+{
+    const char* name;
+    App_Command_Handler_t handler;
+}App_Command_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void App_Command_Task(void const * argument);
+static void App_Command_Receive(char c);
+static void App_Command_Execute(void);
+static bool App_Command_ParseUnsigned(const char* str, uint32_t* value);
+static uint8_t App_Command_Period(const char* arg);
+static uint8_t App_Command_Format(const char* arg);
+static uint8_t App_Command_Dump(const char* arg);
+static uint8_t App_Command_Trace(const char* arg);
+static void App_Command_TransmitFrame(uint32_t size);
+static uint8_t App_Command_Reset(const char* arg);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static osThreadId App_Command_TaskHandle;
+static uint8_t App_Command_Rx[APP_COMMAND_RX_LEN];
+static char App_Command_Line[APP_COMMAND_LINE_LEN];
+static uint32_t App_Command_LineLen;
+static bool App_Command_LineOverflow;
+static Hal_EnergyMonitor_Sample_t App_Command_Batch[APP_COMMAND_DUMP_BATCH];
+static uint8_t App_Command_Telemetry[(APP_COMMAND_DUMP_BATCH * APP_TELEMETRY_FRAME_MAX_LEN) + 1U];    /* Leading delimiter */
+static Trace_Record_t App_Command_TraceBatch[APP_TELEMETRY_TRACE_EVENTS_MAX];
+static TaskStatus_t App_Command_Tasks[APP_COMMAND_TRACE_TASKS];
+
+static const App_Command_t App_Command_Table[] =
+{
+    #define APP_COMMAND(name, handler)  { name, handler },
+        APP_COMMAND_TABLE
+    #undef APP_COMMAND
+};
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP command initialization function
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Command_Init(void)
+{
+    /* Create thread - commands only post requests, the acquisition never waits for them */
+    osThreadDef(App_Command, App_Command_Task, osPriorityLow, 0, 256);
+    App_Command_TaskHandle = osThreadCreate(osThread(App_Command), NULL);
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP command task - data received by the UART DMA is collected into lines
+ *
+ * \param[in] argument OS required parameter
+ * 
+ * \retval None
+ */
+static void App_Command_Task(void const * argument)
+{
+    uint32_t time = osKernelSysTick();
+    uint32_t num;
+
+    while(1)
+    {
+        do
+        {
+            num = Hal_Uart_Read(App_Command_Rx, APP_COMMAND_RX_LEN);
+
+            for(uint32_t i = 0; i < num; i++)
+            {
+                App_Command_Receive((char)App_Command_Rx[i]);
+            }
+        } while(num == APP_COMMAND_RX_LEN);
+
+        osDelayUntil(&time, APP_COMMAND_THREAD_PERIOD);
+    }
+}
+
+/*!	
+ * \brief The function adds the received character to the line, the line is executed at CR or LF
+ *
+ * \param[in] c Received character
+ * 
+ * \retval None
+ */
+static void App_Command_Receive(char c)
+{
+    if((c == '\r') || (c == '\n'))
+    {
+        if(App_Command_LineOverflow)
+        {
+            (void)Log_Write(Log_CommandRejected, 0, 0, 0);
+        }
+        else if(App_Command_LineLen > 0U)
+        {
+            App_Command_Line[App_Command_LineLen] = '\0';
+            App_Command_Execute();
+        }
+        else
+        {
+            /* Empty line, e.g. LF of CR LF */
+        }
+
+        App_Command_LineLen = 0U;
+        App_Command_LineOverflow = false;
+    }
+    else if(App_Command_LineLen < (APP_COMMAND_LINE_LEN - 1U))
+    {
+        App_Command_Line[App_Command_LineLen++] = c;
+    }
+    else
+    {
+        App_Command_LineOverflow = true;
+    }
+}
+
+/*!	
+ * \brief The function looks up the command of the line and calls its handler
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_Command_Execute(void)
+{
+    char* arg = strchr(App_Command_Line, ' ');
+    uint8_t ret_val = APP_COMMAND_CODE_NOT_OK;
+
+    if(arg != NULL)
+    {
+        *arg++ = '\0';
+    }
+    else
+    {
+        arg = &App_Command_Line[App_Command_LineLen];
+    }
+
+    for(uint32_t i = 0; i < (sizeof(App_Command_Table) / sizeof(App_Command_Table[0])); i++)
+    {
+        if(strcmp(App_Command_Line, App_Command_Table[i].name) == 0)
+        {
+            ret_val = App_Command_Table[i].handler(arg);
+            break;
+        }
+    }
+
+    if(ret_val != APP_COMMAND_CODE_OK)
+    {
+        (void)Log_Write(Log_CommandRejected, 0, 0, 0);
+    }
+}
+
+/*!	
+ * \brief The function parses decimal number
+ *
+ * \param[in] str String to parse - digits only
+ * \param[out] value Parsed value
+ * 
+ * \retval true if the string is a valid number
+ */
+static bool App_Command_ParseUnsigned(const char* str, uint32_t* value)
+{
+    uint64_t result = 0U;
+    bool valid = (*str != '\0');
+
+    while(valid && (*str != '\0'))
+    {
+        if((*str >= '0') && (*str <= '9'))
+        {
+            result = (result * 10U) + (uint64_t)(*str - '0');
+            valid = (result <= UINT32_MAX);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        str++;
+    }
+
+    *value = (uint32_t)result;
+
+    return valid;
+}
+
+/*!	
+ * \brief Command handler - set the acquisition period
+ *
+ * \param[in] arg Period in ms
+ * 
+ * \retval Status code
+ */
+static uint8_t App_Command_Period(const char* arg)
+{
+    uint8_t ret_val = APP_COMMAND_CODE_NOT_OK;
+    uint32_t period;
+
+    if(App_Command_ParseUnsigned(arg, &period) && \
+       (Hal_EnergyMonitor_SetPeriod(period) == HAL_ENERGY_MONITOR_CODE_OK))
+    {
+        (void)Log_Write(Log_PeriodSet, (int32_t)Hal_EnergyMonitor_GetPeriod(), 0, 0);
+        ret_val = APP_COMMAND_CODE_OK;
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Command handler - switch the log format
+ *
+ * \param[in] arg Format number
+ * 
+ * \retval Status code
+ */
+static uint8_t App_Command_Format(const char* arg)
+{
+    uint8_t ret_val = APP_COMMAND_CODE_NOT_OK;
+    uint32_t format;
+
+    if(App_Command_ParseUnsigned(arg, &format) && (format < (uint32_t)App_EnergyMonitor_FormatMax) && \
+       (App_EnergyMonitor_SetFormat((App_EnergyMonitor_Format_t)format) == APP_ENERGY_MONITOR_CODE_OK))
+    {
+        (void)Log_Write(Log_FormatSet, (int32_t)format, 0, 0);
+        ret_val = APP_COMMAND_CODE_OK;
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Command handler - send the sample history as binary records, oldest first. The records are
+ *        numbered from 0, so the decoder tells the dump apart from the periodic log. Batches of records
+ *        are paced by the free space of the UART buffer.
+ *
+ * \param[in] arg Not used
+ * 
+ * \retval Status code
+ */
+static uint8_t App_Command_Dump(const char* arg)
+{
+    uint32_t cursor = 0U;   /* Clamped to the oldest sample kept */
+    uint32_t total = 0U;
+    uint32_t num;
+    uint32_t len;
+
+    do
+    {
+        num = Hal_EnergyMonitor_ReadBatch(App_Command_Batch, APP_COMMAND_DUMP_BATCH, &cursor);
+        len = 0U;
+
+        for(uint32_t i = 0; i < num; i++)
+        {
+            len += App_Telemetry_EncodeSample(&App_Command_Telemetry[1U + len], &App_Command_Batch[i], \
+                                              (uint16_t)(total + i), Hal_Gpio_GetAlertStatus());
+        }
+
+        if(len > 0U)
+        {
+            App_Command_TransmitFrame(len);
+        }
+
+        total += num;
+    } while(num == APP_COMMAND_DUMP_BATCH);
+
+    (void)Log_Write(Log_HistoryDumped, (int32_t)total, 0, 0);
+
+    return APP_COMMAND_CODE_OK;
+}
+
+/*!	
+ * \brief Command handler - send the trace buffer: info, names of the tasks and interrupts and the
+ *        events, oldest first. The recording is paused during the dump, so the dump shows the time
+ *        before the command. Frames are paced by the free space of the UART buffer.
+ *
+ * \param[in] arg Not used
+ * 
+ * \retval Status code
+ */
+static uint8_t App_Command_Trace(const char* arg)
+{
+    uint32_t cursor = 0U;
+    uint32_t written;
+    uint32_t total = 0U;
+    uint32_t num;
+    uint16_t sequence = 0U;
+
+    Trace_Stop();
+    written = Trace_GetWritten();
+
+    App_Command_TransmitFrame(App_Telemetry_EncodeTraceInfo(&App_Command_Telemetry[1], SystemCoreClock, written, \
+                                                            (written < TRACE_BUFFER_LEN) ? written : TRACE_BUFFER_LEN));
+
+    num = (uint32_t)uxTaskGetSystemState(App_Command_Tasks, APP_COMMAND_TRACE_TASKS, NULL);
+    for(uint32_t i = 0; i < num; i++)
+    {
+        App_Command_TransmitFrame(App_Telemetry_EncodeTraceName(&App_Command_Telemetry[1], APP_TELEMETRY_TRACE_NAME_TASK, \
+                                                                (uint8_t)App_Command_Tasks[i].xTaskNumber, \
+                                                                App_Command_Tasks[i].pcTaskName));
+    }
+
+    for(uint32_t i = 0; i < (uint32_t)Trace_IsrMax; i++)
+    {
+        App_Command_TransmitFrame(App_Telemetry_EncodeTraceName(&App_Command_Telemetry[1], APP_TELEMETRY_TRACE_NAME_ISR, \
+                                                                (uint8_t)i, Trace_GetIsrName(i)));
+    }
+
+    do
+    {
+        num = Trace_ReadBatch(App_Command_TraceBatch, APP_TELEMETRY_TRACE_EVENTS_MAX, &cursor);
+
+        if(num > 0U)
+        {
+            App_Command_TransmitFrame(App_Telemetry_EncodeTraceEvents(&App_Command_Telemetry[1], App_Command_TraceBatch, \
+                                                                      num, sequence++));
+        }
+
+        total += num;
+    } while(num > 0U);
+
+    Trace_Start();
+
+    (void)Log_Write(Log_TraceDumped, (int32_t)total, (int32_t)(written - total), 0);
+
+    return APP_COMMAND_CODE_OK;
+}
+
+/*!	
+ * \brief The function transmits frames of a long dump encoded at App_Command_Telemetry[1] - with
+ *        a leading delimiter, so the receiver synchronizes after any text of the log. Waits until the
+ *        UART buffer is half empty, so the periodic log keeps its room and nothing is dropped.
+ *
+ * \param[in] size Length of the frames
+ * 
+ * \retval None
+ */
+static void App_Command_TransmitFrame(uint32_t size)
+{
+    Hal_Uart_Stats_t stats;
+
+    Hal_Uart_GetStats(&stats);
+
+    while((stats.queued - stats.sent) > (HAL_UART_TX_BUFFER_LEN / 2U))
+    {
+        osDelay(APP_COMMAND_THREAD_PERIOD);
+        Hal_Uart_GetStats(&stats);
+    }
+
+    App_Command_Telemetry[0] = 0U;
+    (void)Hal_Uart_Write(App_Command_Telemetry, (uint16_t)(size + 1U));
+}
+
+/*!	
+ * \brief Command handler - reset energy and charge counters
+ *
+ * \param[in] arg Not used
+ * 
+ * \retval Status code
+ */
+static uint8_t App_Command_Reset(const char* arg)
+{
+    Hal_EnergyMonitor_ResetEnergy();
+    (void)Log_Write(Log_EnergyReset, 0, 0, 0);
+
+    return APP_COMMAND_CODE_OK;
+}
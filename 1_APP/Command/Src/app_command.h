@@ -0,0 +1,26 @@
+#ifndef _APP_COMMAND_H_
+#define _APP_COMMAND_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+void App_Command_Init(void);
+
+#endif  /* _APP_COMMAND_H_ */
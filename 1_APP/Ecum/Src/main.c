@@ -4,14 +4,20 @@
 
 #include "main.h"
 #include "cmsis_os.h"
+#include "dma.h"
 #include "i2c.h"
 #include "usart.h"
 #include "gpio.h"
+#include "dwt.h"
+#include "log.h"
+#include "trace.h"
 
-#include "ina226.h"
 #include "hal_energy_monitor.h"
 #include "hal_uart.h"
 #include "app_energy_monitor.h"
+#include "app_log.h"
+#include "app_command.h"
+#include "app_bench.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
@@ -70,20 +76,34 @@ int main(void)
   /* Configure the system clock */
   SystemClock_Config();
 
+  /* Cycle counter for timestamps - SystemCoreClock is final here */
+  Dwt_Init();
+
+  /* Log queue - records may be written from now on */
+  Log_Init();
+
+  /* Trace recorder - events are recorded from now on */
+  Trace_Init();
+
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART3_UART_Init();
   MX_I2C1_Init();
 
-  /* DRV layer initialization */
-  INA226_Init();
-
-  /* HAL layer initialization2-0 */
+  /* HAL layer initialization - sensors are configured later by the energy monitor task */
   Hal_EnergyMonitor_Init();
   Hal_Uart_Init();
   
   /* APP layer initialization */
   App_EnergyMonitor_Init();
+  App_Log_Init();
+  App_Command_Init();
+
+#if (BENCH_ENABLE == 1U)
+  /* Benchmark build - the harness task runs above the application */
+  App_Bench_Init();
+#endif
 
   /* Call init function for freertos objects (in freertos.c) */
   MX_FREERTOS_Init();
@@ -11,6 +11,29 @@
 
 #define APP_ENERGY_MONITOR_THREAD_PERIOD    (1000U)
 
+/*
+ * Log format after start-up, see App_EnergyMonitor_Format_t - can be switched at runtime:
+ * 0 - ASCII line per channel every APP_ENERGY_MONITOR_THREAD_PERIOD (window statistics, energy, charge)
+ * 1 - binary record of every sample (~23 bytes, see app_telemetry.h), ~500 records/s fit in 115200 baud
+ * 2 - compressed stream of every sample (keyframe per block, varint deltas, typically 5-8 bytes per sample)
+ */
+#define APP_ENERGY_MONITOR_LOG_FORMAT       (0U)
+#define APP_ENERGY_MONITOR_BINARY_RECORDS   (64U)       /* Binary records buffered before they are written, not a rate limit */
+
+/*
+ * Task statistics report every n periods in the log format - CPU load of the tasks in the n periods and
+ * stack high-water marks, the IDLE load is the headroom left for more channels. 0 - no report.
+ */
+#define APP_ENERGY_MONITOR_TASK_STATS_PERIOD    (10U)
+
+/* Statistics windows: name, length in ms - every sample is added to all windows */
+#define APP_ENERGY_MONITOR_WINDOW_TABLE  \
+    APP_ENERGY_MONITOR_WINDOW(App_EnergyMonitor_Window1s, 1000U)        \
+    APP_ENERGY_MONITOR_WINDOW(App_EnergyMonitor_Window1min, 60000U)     \
+    APP_ENERGY_MONITOR_WINDOW(App_EnergyMonitor_Window15min, 900000U)
+
+#define APP_ENERGY_MONITOR_LOG_WINDOW       (App_EnergyMonitor_Window1s)    /* Window reported in the log */
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
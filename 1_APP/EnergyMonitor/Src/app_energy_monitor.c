@@ -2,13 +2,19 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
-#include <string.h>
-#include <stdio.h>
 #include "app_energy_monitor.h"
 #include "app_energy_monitor_cfg.h"
 #include "hal_energy_monitor.h"
 #include "hal_uart.h"
 #include "hal_gpio.h"
+#include "app_statistics.h"
+#include "app_format.h"
+#include "app_telemetry.h"
+#include "app_task_stats.h"
+#include "app_log.h"
+#include "dwt.h"
+#include "log.h"
+#include "bench.h"
 #include "cmsis_os.h"
 
 /***********************************************************************************************************
@@ -16,10 +22,41 @@
  ***********************************************************************************************************/
 
 #define APP_ENERGY_MONITOR_TICKS_IN_S       (1000U)     /* 1s = 1000 ticks */
+#define APP_ENERGY_MONITOR_NS_IN_US         (1000U)     /* 1us = 1000ns */
+#define APP_ENERGY_MONITOR_NS_IN_MS         (1000000U)  /* 1ms = 1000000ns */
+#define APP_ENERGY_MONITOR_US_IN_S          (1000000U)  /* 1s = 1000000us */
 #define APP_ENERGY_MONITOR_S_IN_MIN         (60U)     /* 1min = 60s */
 #define APP_ENERGY_MONITOR_MIN_IN_H         (60U)     /* 1h = 60min */
 
-#define APP_ENERGY_MONITOR_LOG_LEN          (90U)
+/* One line per channel - fixed text and max length of the numbers (7 int32 and 2 int64 fixed-point, 7 unsigned) */
+#define APP_ENERGY_MONITOR_LINE_TEXT_LEN    (104U)
+#define APP_ENERGY_MONITOR_LINE_LEN         (APP_ENERGY_MONITOR_LINE_TEXT_LEN + (7U * APP_FORMAT_FIXED_32B_MAX_LEN) + \
+                                             (2U * APP_FORMAT_FIXED_MAX_LEN) + (7U * APP_FORMAT_UNSIGNED_32B_MAX_LEN))
+#define APP_ENERGY_MONITOR_BATCH_LEN        (16U)       /* Samples read from the HAL history at once */
+#define APP_ENERGY_MONITOR_SIGNAL_HISTORY   (0x01)      /* Task signal - HAL history half-full */
+#define APP_ENERGY_MONITOR_LOG_LEN          (APP_ENERGY_MONITOR_LINE_LEN * HAL_ENERGY_MONITOR_CHANNELS_NUM)
+
+/* One line per task - fixed text, name and max length of the numbers (load fixed-point, 5 unsigned) */
+#define APP_ENERGY_MONITOR_TASK_LINE_LEN    (48U + APP_TASK_STATS_NAME_LEN + APP_FORMAT_FIXED_32B_MAX_LEN + \
+                                             (5U * APP_FORMAT_UNSIGNED_32B_MAX_LEN))
+#define APP_ENERGY_MONITOR_TASK_LOG_LEN     ((((APP_ENERGY_MONITOR_TASK_LINE_LEN > APP_TELEMETRY_TASK_FRAME_MAX_LEN) ? \
+                                               APP_ENERGY_MONITOR_TASK_LINE_LEN : APP_TELEMETRY_TASK_FRAME_MAX_LEN) * \
+                                              APP_TASK_STATS_TASKS_MAX) + APP_ENERGY_MONITOR_TELEMETRY_START)
+
+/*
+ * Binary log - records or stream blocks buffered before they are written to the UART. Every write starts
+ * with a delimiter at position 0, so the receiver synchronizes after any text of the log.
+ */
+#define APP_ENERGY_MONITOR_TELEMETRY_START  (1U)
+#define APP_ENERGY_MONITOR_STREAM_LEN       (((APP_ENERGY_MONITOR_BINARY_RECORDS * APP_TELEMETRY_ENTRY_MAX_LEN) / \
+                                              (APP_TELEMETRY_BLOCK_LEN - (2U * APP_TELEMETRY_ENTRY_MAX_LEN)) + 2U) * \
+                                             APP_TELEMETRY_BLOCK_FRAME_MAX_LEN)
+#define APP_ENERGY_MONITOR_RECORDS_LEN      (APP_TELEMETRY_FRAME_MAX_LEN * APP_ENERGY_MONITOR_BINARY_RECORDS)
+#define APP_ENERGY_MONITOR_TELEMETRY_LEN    (((APP_ENERGY_MONITOR_STREAM_LEN > APP_ENERGY_MONITOR_RECORDS_LEN) ? \
+                                              APP_ENERGY_MONITOR_STREAM_LEN : APP_ENERGY_MONITOR_RECORDS_LEN) + \
+                                             APP_ENERGY_MONITOR_TELEMETRY_START)
+
+_Static_assert(APP_ENERGY_MONITOR_LOG_FORMAT < App_EnergyMonitor_FormatMax, "Invalid APP_ENERGY_MONITOR_LOG_FORMAT");
 
 /*!	
  * \brief Macro converts global time into hours
@@ -57,12 +94,48 @@
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
 
+typedef enum
+{
+    #define APP_ENERGY_MONITOR_WINDOW(name, length)     name,
+        APP_ENERGY_MONITOR_WINDOW_TABLE
+    #undef APP_ENERGY_MONITOR_WINDOW
+    App_EnergyMonitor_WindowMax
+}App_EnergyMonitor_WindowId_t;
+
+/* Statistics of one completed window */
+typedef struct
+{
+    App_Statistics_Result_t bus_voltage;    /* uV */
+    App_Statistics_Result_t current;        /* uA */
+    App_Statistics_Result_t power;          /* uW */
+    uint64_t end;                           /* ns - acquisition time of the last sample */
+    uint32_t lost;                          /* Samples of the channel missing in the statistics */
+}App_EnergyMonitor_WindowResult_t;
+
+/* Window in progress and the last completed one */
+typedef struct
+{
+    App_Statistics_t bus_voltage;
+    App_Statistics_t current;
+    App_Statistics_t power;
+    uint64_t start;                         /* ns */
+    uint64_t end;                           /* ns */
+    uint32_t lost;
+    bool started;
+    App_EnergyMonitor_WindowResult_t result;
+}App_EnergyMonitor_Window_t;
+
 typedef struct
 {
-    float bus_voltage;          /* V */
-    float current;              /* mA */
-    float power;                /* mW */
-    float power_consumption;    /* mWh: milliwatt-hour */
+    App_EnergyMonitor_Window_t window[App_EnergyMonitor_WindowMax];
+    int64_t power_consumption;  /* nWh: nanowatt-hour */
+    int64_t charge;             /* nAh: nanoampere-hour */
+    uint32_t sequence;          /* Sequence number of the last sample read */
+}App_EnergyMonitor_Channel_t;
+
+typedef struct
+{
+    App_EnergyMonitor_Channel_t channel[HAL_ENERGY_MONITOR_CHANNELS_NUM];
     bool alert_status;
 }App_EnergyMonitor_Data_t;
 
@@ -72,10 +145,24 @@ typedef struct
  ***********************************************************************************************************/
 
 static void App_EnergyMonitor_Task(void const * argument);
+static void App_EnergyMonitor_WaitPeriod(uint32_t* time);
+static void App_EnergyMonitor_HistoryCb(void);
+static void App_EnergyMonitor_UpdateFormat(void);
 static void App_EnergyMonitor_UpdateData(void);
+static void App_EnergyMonitor_UpdateWindow(App_EnergyMonitor_Window_t* window, uint64_t length, \
+                                           const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost);
 static void App_EnergyMonitor_ReadAlertStatus(void);
 static void App_EnergyMonitor_UpdateLeds(void);
 static void App_EnergyMonitor_TransmitLog(void);
+static void App_EnergyMonitor_TransmitTaskStats(void);
+static uint32_t App_EnergyMonitor_FormatTime(char* line, uint64_t time);
+static uint32_t App_EnergyMonitor_FormatTaskLine(char* line, const App_TaskStats_Task_t* task, uint64_t time);
+static void App_EnergyMonitor_TransmitTelemetry(void);
+static void App_EnergyMonitor_EndBlock(void);
+static void App_EnergyMonitor_WriteTelemetry(void);
+static void App_EnergyMonitor_EncodeSample(const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost);
+static void App_EnergyMonitor_TransmitText(void);
+static uint32_t App_EnergyMonitor_FormatLine(char* line, uint8_t channel_num, const App_EnergyMonitor_Channel_t* channel);
 
 /***********************************************************************************************************
  ******************************************** Exported objects *********************************************
@@ -87,7 +174,27 @@ static void App_EnergyMonitor_TransmitLog(void);
 
 static osThreadId App_EnergyMonitor_TaskHandle;
 static App_EnergyMonitor_Data_t App_EnergyMonitor_Data;
+static Hal_EnergyMonitor_Sample_t App_EnergyMonitor_Batch[APP_ENERGY_MONITOR_BATCH_LEN];
+static uint32_t App_EnergyMonitor_Cursor;
+
+/* Window lengths in ns */
+static const uint64_t App_EnergyMonitor_WindowLength[App_EnergyMonitor_WindowMax] =
+{
+    #define APP_ENERGY_MONITOR_WINDOW(name, length)     [name] = (uint64_t)(length) * APP_ENERGY_MONITOR_NS_IN_MS,
+        APP_ENERGY_MONITOR_WINDOW_TABLE
+    #undef APP_ENERGY_MONITOR_WINDOW
+};
+static volatile App_EnergyMonitor_Format_t App_EnergyMonitor_RequestedFormat = APP_ENERGY_MONITOR_LOG_FORMAT;
+static App_EnergyMonitor_Format_t App_EnergyMonitor_Format = APP_ENERGY_MONITOR_LOG_FORMAT;
+static uint8_t App_EnergyMonitor_Telemetry[APP_ENERGY_MONITOR_TELEMETRY_LEN];
+static uint32_t App_EnergyMonitor_TelemetryLen = APP_ENERGY_MONITOR_TELEMETRY_START;
+static App_Telemetry_Stream_t App_EnergyMonitor_Stream;
+static uint16_t App_EnergyMonitor_TelemetrySequence;
 static char App_EnergyMonitor_Log[APP_ENERGY_MONITOR_LOG_LEN];
+static App_TaskStats_t App_EnergyMonitor_TaskStats;
+static uint32_t App_EnergyMonitor_TaskStatsPeriods;
+static uint16_t App_EnergyMonitor_TaskStatsSequence;
+static uint8_t App_EnergyMonitor_TaskLog[APP_ENERGY_MONITOR_TASK_LOG_LEN];
 
 /***********************************************************************************************************
  ******************************************* Exported functions ********************************************
@@ -102,11 +209,53 @@ static char App_EnergyMonitor_Log[APP_ENERGY_MONITOR_LOG_LEN];
  */
 void App_EnergyMonitor_Init(void)
 {
+    App_Telemetry_StreamBegin(&App_EnergyMonitor_Stream);
+    App_Log_SetFramed(App_EnergyMonitor_Format != App_EnergyMonitor_FormatText);
+
     /* Create thread */
     osThreadDef(App_EnergyMonitor, App_EnergyMonitor_Task, osPriorityAboveNormal, 0, 512);
     App_EnergyMonitor_TaskHandle = osThreadCreate(osThread(App_EnergyMonitor), NULL);
+
+    Hal_EnergyMonitor_SetHistoryCb(App_EnergyMonitor_HistoryCb);
+}
+
+/*!	
+ * \brief Switch the log format - the call never blocks, the format is switched by the task
+ *        at the start of the next period
+ *
+ * \param[in] format New log format
+ * 
+ * \retval Status code
+ */
+uint8_t App_EnergyMonitor_SetFormat(App_EnergyMonitor_Format_t format)
+{
+    uint8_t ret_val = APP_ENERGY_MONITOR_CODE_NOT_OK;
+
+    if(format < App_EnergyMonitor_FormatMax)
+    {
+        App_EnergyMonitor_RequestedFormat = format;
+        ret_val = APP_ENERGY_MONITOR_CODE_OK;
+    }
+
+    return ret_val;
 }
 
+#if (BENCH_ENABLE == 1U)
+/*!	
+ * \brief Benchmark of the text log formatting - one line of channel 0, nothing is transmitted
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_EnergyMonitor_BenchFormatLine(void)
+{
+    static char line[APP_ENERGY_MONITOR_LINE_LEN];
+
+    (void)App_EnergyMonitor_FormatLine(line, 0U, &App_EnergyMonitor_Data.channel[0]);
+}
+#endif
+
 /***********************************************************************************************************
  ******************************************** Local functions **********************************************
  ***********************************************************************************************************/
@@ -122,19 +271,84 @@ static void App_EnergyMonitor_Task(void const * argument)
 {
     uint32_t time = osKernelSysTick();
 
+    (void)Log_Write(Log_Startup, HAL_ENERGY_MONITOR_CHANNELS_NUM, 0, 0);
+
     while(1)
     {
+        App_EnergyMonitor_UpdateFormat();
         App_EnergyMonitor_UpdateData();
         App_EnergyMonitor_ReadAlertStatus();
         App_EnergyMonitor_UpdateLeds();
         App_EnergyMonitor_TransmitLog();
+        App_EnergyMonitor_TransmitTaskStats();
+
+        App_EnergyMonitor_WaitPeriod(&time);
+    }
+}
+
+/*!	
+ * \brief The function waits for the next period like osDelayUntil. The HAL history is drained
+ *        whenever it is half-full meanwhile, no sample is lost at any sampling rate.
+ *
+ * \param[in,out] time Start of the current period in ticks, moved to the next one
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_WaitPeriod(uint32_t* time)
+{
+    uint32_t elapsed = osKernelSysTick() - *time;
+
+    while(elapsed < APP_ENERGY_MONITOR_THREAD_PERIOD)
+    {
+        if(osSignalWait(APP_ENERGY_MONITOR_SIGNAL_HISTORY, APP_ENERGY_MONITOR_THREAD_PERIOD - elapsed).status == osEventSignal)
+        {
+            App_EnergyMonitor_UpdateData();
+        }
+
+        elapsed = osKernelSysTick() - *time;
+    }
+
+    *time += APP_ENERGY_MONITOR_THREAD_PERIOD;
+}
+
+/*!	
+ * \brief HAL history half-full callback - called from the HAL task
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_HistoryCb(void)
+{
+    (void)osSignalSet(App_EnergyMonitor_TaskHandle, APP_ENERGY_MONITOR_SIGNAL_HISTORY);
+}
 
-        osDelayUntil(&time, APP_ENERGY_MONITOR_THREAD_PERIOD);
+/*!	
+ * \brief The function switches to the requested log format - binary data of the previous format
+ *        not transmitted yet is discarded, a new stream starts with a keyframe. Log lines are framed
+ *        in the binary formats.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_UpdateFormat(void)
+{
+    App_EnergyMonitor_Format_t format = App_EnergyMonitor_RequestedFormat;
+
+    if(format != App_EnergyMonitor_Format)
+    {
+        App_EnergyMonitor_TelemetryLen = APP_ENERGY_MONITOR_TELEMETRY_START;
+        App_Telemetry_StreamBegin(&App_EnergyMonitor_Stream);
+        App_EnergyMonitor_Format = format;
+        App_Log_SetFramed(format != App_EnergyMonitor_FormatText);
     }
 }
 
 /*!	
- * \brief The function updates the required variables
+ * \brief The function updates the required variables - all samples acquired since the last call
+ *        are added to the statistics windows. Samples overwritten in the HAL history before they
+ *        were read show as gaps in the sequence numbers of the channel, they are counted as lost.
  *
  * \param[in] None
  * 
@@ -142,17 +356,85 @@ static void App_EnergyMonitor_Task(void const * argument)
  */
 static void App_EnergyMonitor_UpdateData(void)
 {
-    Hal_EnergyMonitor_Data_t data;
+    Hal_EnergyMonitor_Energy_t energy;
+    App_EnergyMonitor_Channel_t* channel;
+    uint32_t num;
+    uint32_t lost;
 
-    Hal_EnergyMonitor_GetResults(&data);
-    App_EnergyMonitor_Data.bus_voltage = data.bus_voltage;
-    App_EnergyMonitor_Data.power = data.power;
-    App_EnergyMonitor_Data.current = data.current;
+    do
+    {
+        num = Hal_EnergyMonitor_ReadBatch(App_EnergyMonitor_Batch, APP_ENERGY_MONITOR_BATCH_LEN, &App_EnergyMonitor_Cursor);
+
+        for(uint32_t i = 0; i < num; i++)
+        {
+            channel = &App_EnergyMonitor_Data.channel[App_EnergyMonitor_Batch[i].channel];
+            lost = App_EnergyMonitor_Batch[i].sequence - channel->sequence - 1U;
+            channel->sequence = App_EnergyMonitor_Batch[i].sequence;
+
+            for(uint8_t w = 0; w < App_EnergyMonitor_WindowMax; w++)
+            {
+                App_EnergyMonitor_UpdateWindow(&channel->window[w], App_EnergyMonitor_WindowLength[w], \
+                                               &App_EnergyMonitor_Batch[i], lost);
+            }
+
+            if(App_EnergyMonitor_Format != App_EnergyMonitor_FormatText)
+            {
+                App_EnergyMonitor_EncodeSample(&App_EnergyMonitor_Batch[i], lost);
+            }
+        }
+    } while(num == APP_ENERGY_MONITOR_BATCH_LEN);
+
+    for(uint8_t i = 0; i < HAL_ENERGY_MONITOR_CHANNELS_NUM; i++)
+    {
+        channel = &App_EnergyMonitor_Data.channel[i];
 
-    /* Conversion to milliwatt-hour */
-    App_EnergyMonitor_Data.power_consumption += App_EnergyMonitor_Data.power * \
-                                                ((float)(APP_ENERGY_MONITOR_THREAD_PERIOD / APP_ENERGY_MONITOR_TICKS_IN_S)) / \
-                                                (float)APP_ENERGY_MONITOR_S_IN_MIN / (float)APP_ENERGY_MONITOR_MIN_IN_H;
+        /* Integrated by the HAL at the acquisition rate */
+        Hal_EnergyMonitor_GetEnergy(i, &energy);
+        channel->power_consumption = energy.energy;
+        channel->charge = energy.charge;
+    }
+}
+
+/*!	
+ * \brief The function adds the sample to the window. The window is closed by the first sample
+ *        past its length, the statistics are kept until the next window closes.
+ *
+ * \param[in] window Window to update
+ * \param[in] length Window length in ns
+ * \param[in] sample Sample to add
+ * \param[in] lost Samples of the channel lost just before this one
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_UpdateWindow(App_EnergyMonitor_Window_t* window, uint64_t length, \
+                                           const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost)
+{
+    if(window->started && ((sample->timestamp - window->start) >= length))
+    {
+        App_Statistics_GetResult(&window->bus_voltage, &window->result.bus_voltage);
+        App_Statistics_GetResult(&window->current, &window->result.current);
+        App_Statistics_GetResult(&window->power, &window->result.power);
+        window->result.end = window->end;
+        window->result.lost = window->lost;
+
+        window->started = false;
+    }
+
+    if(!window->started)
+    {
+        App_Statistics_Reset(&window->bus_voltage);
+        App_Statistics_Reset(&window->current);
+        App_Statistics_Reset(&window->power);
+        window->start = sample->timestamp;
+        window->lost = 0U;
+        window->started = true;
+    }
+
+    App_Statistics_Add(&window->bus_voltage, sample->bus_voltage, sample->timestamp);
+    App_Statistics_Add(&window->current, sample->current, sample->timestamp);
+    App_Statistics_Add(&window->power, sample->power, sample->timestamp);
+    window->end = sample->timestamp;
+    window->lost += lost;
 }
 
 /*!	
@@ -197,30 +479,298 @@ static void App_EnergyMonitor_UpdateLeds(void)
 }
 
 /*!	
- * \brief The function tranmit log via serial port. Data to be transmitted:
- *        - time since system start-up
- *        - bus voltage
- *        - current
- *        - power
+ * \brief The function tranmit log via serial port in the selected format
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_TransmitLog(void)
+{
+    BENCH_PROBE_BEGIN(Bench_TransmitLog);
+
+    if(App_EnergyMonitor_Format == App_EnergyMonitor_FormatText)
+    {
+        App_EnergyMonitor_TransmitText();
+    }
+    else
+    {
+        App_EnergyMonitor_TransmitTelemetry();
+    }
+
+    BENCH_PROBE_END(Bench_TransmitLog);
+}
+
+/*!	
+ * \brief The function tranmit task statistics via serial port every APP_ENERGY_MONITOR_TASK_STATS_PERIOD
+ *        in the selected format - line or record per task
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_TransmitTaskStats(void)
+{
+    uint64_t time;
+    uint32_t len = 0U;
+
+    App_EnergyMonitor_TaskStatsPeriods++;
+
+    if((APP_ENERGY_MONITOR_TASK_STATS_PERIOD > 0U) && (App_EnergyMonitor_TaskStatsPeriods >= APP_ENERGY_MONITOR_TASK_STATS_PERIOD))
+    {
+        App_EnergyMonitor_TaskStatsPeriods = 0U;
+
+        App_TaskStats_Update(&App_EnergyMonitor_TaskStats);
+        time = Dwt_CyclesToNs(Dwt_GetCycles());
+
+        if(App_EnergyMonitor_Format != App_EnergyMonitor_FormatText)
+        {
+            App_EnergyMonitor_TaskLog[len++] = 0U;     /* Leading delimiter of the records */
+        }
+
+        for(uint32_t i = 0U; i < App_EnergyMonitor_TaskStats.num; i++)
+        {
+            if(App_EnergyMonitor_Format == App_EnergyMonitor_FormatText)
+            {
+                len += App_EnergyMonitor_FormatTaskLine((char*)&App_EnergyMonitor_TaskLog[len], \
+                                                        &App_EnergyMonitor_TaskStats.task[i], time);
+            }
+            else
+            {
+                len += App_Telemetry_EncodeTask(&App_EnergyMonitor_TaskLog[len], &App_EnergyMonitor_TaskStats.task[i], \
+                                                (uint8_t)i, App_EnergyMonitor_TaskStatsSequence, time);
+            }
+        }
+
+        App_EnergyMonitor_TaskStatsSequence++;
+
+        (void)Hal_Uart_Write(App_EnergyMonitor_TaskLog, (uint16_t)len);
+    }
+}
+
+/*!	
+ * \brief The function tranmit binary log via serial port - records of the samples read in the period
+ *        not written yet
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_TransmitTelemetry(void)
+{
+    if(App_EnergyMonitor_Format == App_EnergyMonitor_FormatStream)
+    {
+        App_EnergyMonitor_EndBlock();
+    }
+
+    App_EnergyMonitor_WriteTelemetry();
+}
+
+/*!	
+ * \brief The function closes the compressed stream block into the binary log and starts the next
+ *        one - the log is written out first if the block does not fit
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_EndBlock(void)
+{
+    if((App_EnergyMonitor_TelemetryLen + APP_TELEMETRY_BLOCK_FRAME_MAX_LEN) > APP_ENERGY_MONITOR_TELEMETRY_LEN)
+    {
+        App_EnergyMonitor_WriteTelemetry();
+    }
+
+    App_EnergyMonitor_TelemetryLen += App_Telemetry_StreamEnd(&App_EnergyMonitor_Stream, \
+                                                              &App_EnergyMonitor_Telemetry[App_EnergyMonitor_TelemetryLen]);
+    App_Telemetry_StreamBegin(&App_EnergyMonitor_Stream);
+}
+
+/*!	
+ * \brief The function writes the binary log buffered so far to the serial port - with a leading
+ *        delimiter, like App_Command_TransmitFrame
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_WriteTelemetry(void)
+{
+    if(App_EnergyMonitor_TelemetryLen > APP_ENERGY_MONITOR_TELEMETRY_START)
+    {
+        App_EnergyMonitor_Telemetry[0] = 0U;
+        (void)Hal_Uart_Write(App_EnergyMonitor_Telemetry, (uint16_t)App_EnergyMonitor_TelemetryLen);
+        App_EnergyMonitor_TelemetryLen = APP_ENERGY_MONITOR_TELEMETRY_START;
+    }
+}
+
+/*!	
+ * \brief The function appends the sample to the binary log - as a record or to the compressed
+ *        stream block. A full buffer is written out at once, nothing is dropped. Samples lost
+ *        before the record leave a gap in the record sequence numbers, samples lost before the
+ *        stream entry start a new block which counts them in its header.
+ *
+ * \param[in] sample Sample to log
+ * \param[in] lost Samples of the channel lost in the HAL history just before this one
+ * 
+ * \retval None
+ */
+static void App_EnergyMonitor_EncodeSample(const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost)
+{
+    if(App_EnergyMonitor_Format == App_EnergyMonitor_FormatStream)
+    {
+        if(!App_Telemetry_StreamAdd(&App_EnergyMonitor_Stream, sample, lost, App_EnergyMonitor_Data.alert_status))
+        {
+            App_EnergyMonitor_EndBlock();
+            (void)App_Telemetry_StreamAdd(&App_EnergyMonitor_Stream, sample, lost, App_EnergyMonitor_Data.alert_status);
+        }
+    }
+    else
+    {
+        App_EnergyMonitor_TelemetrySequence += (uint16_t)lost;
+
+        if((App_EnergyMonitor_TelemetryLen + APP_TELEMETRY_FRAME_MAX_LEN) > APP_ENERGY_MONITOR_TELEMETRY_LEN)
+        {
+            App_EnergyMonitor_WriteTelemetry();
+        }
+
+        App_EnergyMonitor_TelemetryLen += App_Telemetry_EncodeSample(&App_EnergyMonitor_Telemetry[App_EnergyMonitor_TelemetryLen], \
+                                                                     sample, App_EnergyMonitor_TelemetrySequence, \
+                                                                     App_EnergyMonitor_Data.alert_status);
+        App_EnergyMonitor_TelemetrySequence++;
+    }
+}
+
+/*!	
+ * \brief The function tranmit log via serial port. One line per channel, data to be transmitted:
+ *        - acquisition time of the last sample of the window since system start-up (us resolution)
+ *        - channel number
+ *        - bus voltage - mean of the window
+ *        - current - mean, min, max and RMS of the window
+ *        - power - mean and max of the window
  *        - power consumption
+ *        - charge
  *        - alert status
  *
  * \param[in] None
  * 
  * \retval None
  */
-static void App_EnergyMonitor_TransmitLog(void)
+static void App_EnergyMonitor_TransmitText(void)
 {
-    uint32_t time_global = osKernelSysTick();
-    uint8_t time_h = App_EnergyMonitor_GetHours(time_global);
-    uint8_t time_min = App_EnergyMonitor_GetMinutes(time_global, time_h);
-    uint8_t time_s = App_EnergyMonitor_GetSeconds(time_global, time_min);
+    uint32_t len = 0U;
+
+    for(uint8_t i = 0; i < HAL_ENERGY_MONITOR_CHANNELS_NUM; i++)
+    {
+        len += App_EnergyMonitor_FormatLine(&App_EnergyMonitor_Log[len], i, &App_EnergyMonitor_Data.channel[i]);
+    }
 
-    memset(App_EnergyMonitor_Log, '\0', sizeof(App_EnergyMonitor_Log));
+    (void)Hal_Uart_Write((uint8_t*)App_EnergyMonitor_Log, (uint16_t)len);
+}
+
+/*!	
+ * \brief The function formats one log line - without printf, the length never exceeds
+ *        APP_ENERGY_MONITOR_LINE_LEN
+ *
+ * \param[out] line Output position
+ * \param[in] channel_num Channel number
+ * \param[in] channel Channel data
+ * 
+ * \retval Line length
+ */
+static uint32_t App_EnergyMonitor_FormatLine(char* line, uint8_t channel_num, const App_EnergyMonitor_Channel_t* channel)
+{
+    const App_EnergyMonitor_WindowResult_t* result = &channel->window[APP_ENERGY_MONITOR_LOG_WINDOW].result;
+    uint32_t len = 0U;
+
+    /* hh::mm::ss.uuuuuu CHn U= x.xx[V] I=x.xx (x.xx..x.xx, RMS x.xx) [mA] P=x.xx (max x.xx) [mW] Consumption=x.xx [mWh] Charge=x.xxx [mAh] Lost:n Alert:n */
+    len += App_EnergyMonitor_FormatTime(&line[len], result->end);   /* Time of the acquisition, not of the transmission */
+    len += App_Format_String(&line[len], " CH");
+    len += App_Format_Unsigned(&line[len], channel_num, 1U);
+    len += App_Format_String(&line[len], " U= ");
+    len += App_Format_Fixed(&line[len], result->bus_voltage.mean, 6U, 2U);    /* uV -> V */
+    len += App_Format_String(&line[len], "[V] I=");
+    len += App_Format_Fixed(&line[len], result->current.mean, 3U, 2U);        /* uA -> mA */
+    len += App_Format_String(&line[len], " (");
+    len += App_Format_Fixed(&line[len], result->current.min, 3U, 2U);
+    len += App_Format_String(&line[len], "..");
+    len += App_Format_Fixed(&line[len], result->current.max, 3U, 2U);
+    len += App_Format_String(&line[len], ", RMS ");
+    len += App_Format_Fixed(&line[len], result->current.rms, 3U, 2U);
+    len += App_Format_String(&line[len], ") [mA] P=");
+    len += App_Format_Fixed(&line[len], result->power.mean, 3U, 2U);          /* uW -> mW */
+    len += App_Format_String(&line[len], " (max ");
+    len += App_Format_Fixed(&line[len], result->power.max, 3U, 2U);
+    len += App_Format_String(&line[len], ") [mW] Consumption=");
+    len += App_Format_Fixed(&line[len], channel->power_consumption, 6U, 2U);  /* nWh -> mWh */
+    len += App_Format_String(&line[len], " [mWh] Charge=");
+    len += App_Format_Fixed(&line[len], channel->charge, 6U, 3U);             /* nAh -> mAh */
+    len += App_Format_String(&line[len], " [mAh] Lost:");
+    len += App_Format_Unsigned(&line[len], result->lost, 1U);
+    len += App_Format_String(&line[len], " Alert:");
+    len += App_Format_Unsigned(&line[len], App_EnergyMonitor_Data.alert_status, 1U);
+    len += App_Format_String(&line[len], "\r\n");
+
+    return len;
+}
 
-    sprintf(App_EnergyMonitor_Log, "%.2d::%.2d::%.2d U= %.2f[V] I=%.2f [mA] P=%.2f [mW] Consumption=%.2f [mWh] Alert:%d\r\n", \
-            time_h, time_min, time_s, App_EnergyMonitor_Data.bus_voltage, App_EnergyMonitor_Data.current, \
-            App_EnergyMonitor_Data.power, App_EnergyMonitor_Data.power_consumption, App_EnergyMonitor_Data.alert_status);
+/*!	
+ * \brief The function formats one task statistics line - the length never exceeds
+ *        APP_ENERGY_MONITOR_TASK_LINE_LEN
+ *
+ * \param[out] line Output position
+ * \param[in] task Task statistics
+ * \param[in] time Time of the report in ns
+ * 
+ * \retval Line length
+ */
+static uint32_t App_EnergyMonitor_FormatTaskLine(char* line, const App_TaskStats_Task_t* task, uint64_t time)
+{
+    uint32_t len = 0U;
+
+    /* hh::mm::ss.uuuuuu TASK name CPU=x.xx [%] Stack=n [words] */
+    len += App_EnergyMonitor_FormatTime(&line[len], time);
+    len += App_Format_String(&line[len], " TASK ");
+    len += App_Format_String(&line[len], task->name);
+    len += App_Format_String(&line[len], " CPU=");
+    len += App_Format_Fixed(&line[len], task->load, 2U, 2U);              /* 0.01 % -> % */
+    len += App_Format_String(&line[len], " [%] Stack=");
+    len += App_Format_Unsigned(&line[len], task->stack, 1U);
+    len += App_Format_String(&line[len], " [words]\r\n");
+
+    return len;
+}
 
-    (void)Hal_Uart_Write((uint8_t*)App_EnergyMonitor_Log, sizeof(App_EnergyMonitor_Log));
+/*!	
+ * \brief The function formats the time since system start-up as hh::mm::ss.uuuuuu
+ *
+ * \param[out] line Output position
+ * \param[in] time Time in ns
+ * 
+ * \retval Length
+ */
+static uint32_t App_EnergyMonitor_FormatTime(char* line, uint64_t time)
+{
+    uint32_t time_global;
+    uint32_t time_us;
+    uint8_t time_h;
+    uint8_t time_min;
+    uint8_t time_s;
+    uint32_t len = 0U;
+
+    time_global = (uint32_t)(time / APP_ENERGY_MONITOR_NS_IN_MS);
+    time_us = (uint32_t)((time / APP_ENERGY_MONITOR_NS_IN_US) % APP_ENERGY_MONITOR_US_IN_S);
+    time_h = App_EnergyMonitor_GetHours(time_global);
+    time_min = App_EnergyMonitor_GetMinutes(time_global, time_h);
+    time_s = App_EnergyMonitor_GetSeconds(time_global, time_min);
+
+    len += App_Format_Unsigned(&line[len], time_h, 2U);
+    len += App_Format_String(&line[len], "::");
+    len += App_Format_Unsigned(&line[len], time_min, 2U);
+    len += App_Format_String(&line[len], "::");
+    len += App_Format_Unsigned(&line[len], time_s, 2U);
+    len += App_Format_String(&line[len], ".");
+    len += App_Format_Unsigned(&line[len], time_us, 6U);
+
+    return len;
 }
@@ -5,14 +5,30 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include <stdint.h>
+
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
+/*
+ * Status codes
+ */
+#define APP_ENERGY_MONITOR_CODE_OK          (0U)
+#define APP_ENERGY_MONITOR_CODE_NOT_OK      (1U)
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
 
+typedef enum
+{
+    App_EnergyMonitor_FormatText = 0,   /* ASCII line per channel */
+    App_EnergyMonitor_FormatRecords,    /* Binary record of every sample */
+    App_EnergyMonitor_FormatStream,     /* Compressed stream of every sample */
+    App_EnergyMonitor_FormatMax
+}App_EnergyMonitor_Format_t;
+
 /***********************************************************************************************************
  ********************************************* Exported objects ********************************************
  ***********************************************************************************************************/
@@ -22,5 +38,11 @@
  ***********************************************************************************************************/
 
 void App_EnergyMonitor_Init(void);
+uint8_t App_EnergyMonitor_SetFormat(App_EnergyMonitor_Format_t format);
+
+/*
+ * Benchmarks - BENCH_ENABLE build only
+ */
+void App_EnergyMonitor_BenchFormatLine(void);
 
 #endif  /* _APP_ENERGY_MONITOR_H_ */
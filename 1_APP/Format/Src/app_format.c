@@ -0,0 +1,155 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "app_format.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_FORMAT_POW10_NUM            ((uint8_t)(sizeof(App_Format_Pow10) / sizeof(App_Format_Pow10[0])))
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static const uint64_t App_Format_Pow10[] =
+{
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL,
+    1000000000ULL, 10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL
+};
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Copy string
+ *
+ * \param[out] buf Output position
+ * \param[in] str String terminated with '\0'
+ * 
+ * \retval Number of written characters
+ */
+uint32_t App_Format_String(char* buf, const char* str)
+{
+    uint32_t len = 0U;
+
+    while(str[len] != '\0')
+    {
+        buf[len] = str[len];
+        len++;
+    }
+
+    return len;
+}
+
+/*!	
+ * \brief Format unsigned number in decimal, zero padded to the width
+ *
+ * \param[out] buf Output position, at least App_Format_UnsignedLen(width) characters
+ * \param[in] value Number
+ * \param[in] width Min number of digits
+ * 
+ * \retval Number of written characters
+ */
+uint32_t App_Format_Unsigned(char* buf, uint64_t value, uint8_t width)
+{
+    char digits[APP_FORMAT_UNSIGNED_MAX_LEN];
+    uint32_t num = 0U;
+    uint32_t len = 0U;
+
+    /* 32-bit division when possible - 64-bit one is a library call */
+    while(value > UINT32_MAX)
+    {
+        digits[num++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    }
+
+    for(uint32_t value_32b = (uint32_t)value; (value_32b != 0U) || (num == 0U); value_32b /= 10U)
+    {
+        digits[num++] = (char)('0' + (value_32b % 10U));
+    }
+
+    while((len + num) < width)
+    {
+        buf[len++] = '0';
+    }
+
+    while(num > 0U)
+    {
+        buf[len++] = digits[--num];
+    }
+
+    return len;
+}
+
+/*!	
+ * \brief Format fixed-point number in decimal, rounded half away from zero.
+ *        E.g. value 1234567 in uV (scale 6) with 2 decimals gives "1.23" [V].
+ *
+ * \param[out] buf Output position, at least APP_FORMAT_FIXED_MAX_LEN characters
+ * \param[in] value Number in units of 10^-scale
+ * \param[in] scale Number of decimal digits of the value unit
+ * \param[in] decimals Number of decimals to print, not more than scale
+ * 
+ * \retval Number of written characters
+ */
+uint32_t App_Format_Fixed(char* buf, int64_t value, uint8_t scale, uint8_t decimals)
+{
+    uint64_t magnitude = (value < 0) ? (0U - (uint64_t)value) : (uint64_t)value;
+    uint64_t divisor;
+    uint64_t integer;
+    uint64_t fraction;
+    uint32_t len = 0U;
+
+    if(scale >= APP_FORMAT_POW10_NUM)
+    {
+        scale = APP_FORMAT_POW10_NUM - 1U;
+    }
+
+    if(decimals > scale)
+    {
+        decimals = scale;
+    }
+
+    /* Round to the printed decimals */
+    divisor = App_Format_Pow10[scale - decimals];
+    magnitude = (magnitude / divisor) + (((magnitude % divisor) >= ((divisor + 1U) / 2U)) ? 1U : 0U);
+    integer = magnitude / App_Format_Pow10[decimals];
+    fraction = magnitude % App_Format_Pow10[decimals];
+
+    if((value < 0) && (magnitude != 0U))
+    {
+        buf[len++] = '-';
+    }
+
+    len += App_Format_Unsigned(&buf[len], integer, 1U);
+
+    if(decimals > 0U)
+    {
+        buf[len++] = '.';
+        len += App_Format_Unsigned(&buf[len], fraction, decimals);
+    }
+
+    return len;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
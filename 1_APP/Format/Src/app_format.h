@@ -0,0 +1,62 @@
+#ifndef _APP_FORMAT_H_
+#define _APP_FORMAT_H_
+
+/* 
+ * Fixed-point to decimal formatter - replaces printf in the logs. Functions write at the given position
+ * without the terminating '\0' and return the number of written characters. Max lengths below are known
+ * at compile time, so the caller sizes its buffer without checks at runtime.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_FORMAT_UNSIGNED_MAX_LEN     (20U)   /* 2^64 - 1 */
+#define APP_FORMAT_UNSIGNED_32B_MAX_LEN (10U)   /* 2^32 - 1 */
+#define APP_FORMAT_FIXED_MAX_LEN        (22U)   /* Sign, 20 digits and decimal point */
+#define APP_FORMAT_FIXED_32B_MAX_LEN    (12U)   /* Sign, 10 digits and decimal point - int32_t value */
+
+/*!	
+ * \brief Max length of the unsigned number formatted with the width
+ *
+ * \param[in] width Min number of digits
+ * 
+ * \retval Max number of characters
+ */
+#define App_Format_UnsignedLen(width)   (((width) > APP_FORMAT_UNSIGNED_MAX_LEN) ? (width) : APP_FORMAT_UNSIGNED_MAX_LEN)
+
+/*!	
+ * \brief Length of the string literal
+ *
+ * \param[in] str String literal
+ * 
+ * \retval Number of characters without '\0'
+ */
+#define App_Format_LiteralLen(str)      (sizeof(str) - 1U)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+uint32_t App_Format_String(char* buf, const char* str);
+uint32_t App_Format_Unsigned(char* buf, uint64_t value, uint8_t width);
+uint32_t App_Format_Fixed(char* buf, int64_t value, uint8_t scale, uint8_t decimals);
+
+#endif  /* _APP_FORMAT_H_ */
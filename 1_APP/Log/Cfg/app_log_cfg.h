@@ -0,0 +1,28 @@
+#ifndef _APP_LOG_CFG_H_
+#define _APP_LOG_CFG_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_LOG_THREAD_PERIOD           (20U)   /* ms - queue drain period */
+#define APP_LOG_TEXT_MAX_LEN            (64U)   /* Max length of the message text */
+#define APP_LOG_LINES_NUM               (8U)    /* Lines transmitted at once */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _APP_LOG_CFG_H_ */
@@ -0,0 +1,227 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "app_log.h"
+#include "app_log_cfg.h"
+#include "app_format.h"
+#include "app_telemetry.h"
+#include "hal_uart.h"
+#include "log.h"
+#include "cmsis_os.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_LOG_NS_IN_US                (1000U)     /* 1us = 1000ns */
+
+/* [s.uuuuuu] text\r\n - every argument may replace its 2 character placeholder */
+#define APP_LOG_LINE_LEN                (App_Format_LiteralLen("[] \r\n") + APP_FORMAT_FIXED_MAX_LEN + \
+                                         APP_LOG_TEXT_MAX_LEN + (LOG_ARGS_NUM * APP_FORMAT_FIXED_32B_MAX_LEN))
+#define APP_LOG_FRAME_LEN               (APP_LOG_LINE_LEN + APP_TELEMETRY_TEXT_OVERHEAD)
+#define APP_LOG_BUFFER_LEN              ((APP_LOG_FRAME_LEN * APP_LOG_LINES_NUM) + 1U)     /* Leading delimiter of the frames */
+
+_Static_assert(APP_LOG_LINE_LEN <= APP_TELEMETRY_TEXT_MAX_LEN, "Log line does not fit in the telemetry text frame");
+
+#define LOG_MESSAGE(id, text)   _Static_assert(App_Format_LiteralLen(text) <= APP_LOG_TEXT_MAX_LEN, \
+                                               #id " text is longer than APP_LOG_TEXT_MAX_LEN");
+    LOG_MESSAGE_TABLE
+#undef LOG_MESSAGE
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void App_Log_Task(void const * argument);
+static void App_Log_CheckDropped(void);
+static uint32_t App_Log_FormatLine(char* line, const Log_Record_t* record);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static osThreadId App_Log_TaskHandle;
+static char App_Log_Buffer[APP_LOG_BUFFER_LEN];
+static char App_Log_Line[APP_LOG_LINE_LEN];
+static volatile bool App_Log_Framed;    /* Lines sent as telemetry frames - a binary log format is selected */
+static uint32_t App_Log_Dropped;        /* Log records reported as dropped */
+static uint32_t App_Log_UartDropped;    /* UART bytes reported as dropped */
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP log initialization function
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Log_Init(void)
+{
+    /* Create thread - below the measurement, formatting and UART latency never delay it */
+    osThreadDef(App_Log, App_Log_Task, osPriorityLow, 0, 256);
+    App_Log_TaskHandle = osThreadCreate(osThread(App_Log), NULL);
+}
+
+/*!	
+ * \brief Select plain text lines or lines framed as telemetry (APP_TELEMETRY_TYPE_TEXT) - with a
+ *        binary log format a text line would corrupt the frames around it
+ *
+ * \param[in] framed True to frame the lines
+ * 
+ * \retval None
+ */
+void App_Log_SetFramed(bool framed)
+{
+    App_Log_Framed = framed;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief APP log task - drains the log queue, the records are formatted into lines and transmitted
+ *        APP_LOG_LINES_NUM lines at once, each line in its own frame after a leading delimiter when
+ *        framed
+ *
+ * \param[in] argument OS required parameter
+ * 
+ * \retval None
+ */
+static void App_Log_Task(void const * argument)
+{
+    uint32_t time = osKernelSysTick();
+    Log_Record_t record;
+    uint32_t lines;
+    uint32_t len;
+    bool framed;
+
+    while(1)
+    {
+        App_Log_CheckDropped();
+
+        do
+        {
+            framed = App_Log_Framed;
+            lines = 0U;
+            len = 0U;
+
+            if(framed)
+            {
+                App_Log_Buffer[len++] = '\0';     /* Leading delimiter, as App_Command_TransmitFrame */
+            }
+
+            while((lines < APP_LOG_LINES_NUM) && Log_Read(&record))
+            {
+                if(framed)
+                {
+                    len += App_Telemetry_EncodeText((uint8_t*)&App_Log_Buffer[len], App_Log_Line, \
+                                                    App_Log_FormatLine(App_Log_Line, &record));
+                }
+                else
+                {
+                    len += App_Log_FormatLine(&App_Log_Buffer[len], &record);
+                }
+
+                lines++;
+            }
+
+            if(lines > 0U)
+            {
+                (void)Hal_Uart_Write((const uint8_t*)App_Log_Buffer, (uint16_t)len);
+            }
+        } while(lines == APP_LOG_LINES_NUM);
+
+        osDelayUntil(&time, APP_LOG_THREAD_PERIOD);
+    }
+}
+
+/*!	
+ * \brief The function reports records and UART bytes dropped since the last check - the reports
+ *        go through the queue, so they are dropped as well if it is still full
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void App_Log_CheckDropped(void)
+{
+    uint32_t dropped = Log_GetDropped();
+    Hal_Uart_Stats_t stats;
+
+    if(dropped != App_Log_Dropped)
+    {
+        if(Log_Write(Log_Dropped, (int32_t)(dropped - App_Log_Dropped), 0, 0))
+        {
+            App_Log_Dropped = dropped;
+        }
+    }
+
+    Hal_Uart_GetStats(&stats);
+
+    if(stats.dropped != App_Log_UartDropped)
+    {
+        if(Log_Write(Log_UartDropped, (int32_t)(stats.dropped - App_Log_UartDropped), 0, 0))
+        {
+            App_Log_UartDropped = stats.dropped;
+        }
+    }
+}
+
+/*!	
+ * \brief The function formats one log line - the length never exceeds APP_LOG_LINE_LEN
+ *
+ * \param[out] line Output position
+ * \param[in] record Log record
+ * 
+ * \retval Line length
+ */
+static uint32_t App_Log_FormatLine(char* line, const Log_Record_t* record)
+{
+    const char* text = Log_GetText(record->id);
+    uint8_t arg = 0U;
+    uint32_t len = 0U;
+
+    /* [s.uuuuuu] */
+    line[len++] = '[';
+    len += App_Format_Fixed(&line[len], (int64_t)(record->timestamp / APP_LOG_NS_IN_US), 6U, 6U);
+    len += App_Format_String(&line[len], "] ");
+
+    for(uint32_t i = 0; text[i] != '\0'; i++)
+    {
+        if((text[i] == '%') && (arg < LOG_ARGS_NUM) && ((text[i + 1U] == 'd') || (text[i + 1U] == 'u')))
+        {
+            if(text[i + 1U] == 'd')
+            {
+                len += App_Format_Fixed(&line[len], record->args[arg], 0U, 0U);
+            }
+            else
+            {
+                len += App_Format_Unsigned(&line[len], (uint32_t)record->args[arg], 1U);
+            }
+
+            arg++;
+            i++;
+        }
+        else
+        {
+            line[len++] = text[i];
+        }
+    }
+
+    len += App_Format_String(&line[len], "\r\n");
+
+    return len;
+}
@@ -0,0 +1,29 @@
+#ifndef _APP_LOG_H_
+#define _APP_LOG_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdbool.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+void App_Log_Init(void);
+void App_Log_SetFramed(bool framed);
+
+#endif  /* _APP_LOG_H_ */
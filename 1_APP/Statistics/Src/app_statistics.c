@@ -0,0 +1,119 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <math.h>
+#include "app_statistics.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Clear statistics
+ *
+ * \param[in] stats Statistics to clear
+ * 
+ * \retval None
+ */
+void App_Statistics_Reset(App_Statistics_t* stats)
+{
+    stats->count = 0U;
+    stats->mean = 0.0;
+    stats->m2 = 0.0;
+    stats->min = INT32_MAX;
+    stats->max = INT32_MIN;
+    stats->peak_timestamp = 0U;
+}
+
+/*!	
+ * \brief Add sample - O(1), double precision is done by the FPU (FPv5-D16)
+ *
+ * \param[in] stats Statistics to update
+ * \param[in] value Sample value
+ * \param[in] timestamp Sample timestamp
+ * 
+ * \retval None
+ */
+void App_Statistics_Add(App_Statistics_t* stats, int32_t value, uint64_t timestamp)
+{
+    double delta;
+
+    stats->count++;
+
+    /* Welford */
+    delta = (double)value - stats->mean;
+    stats->mean += delta / (double)stats->count;
+    stats->m2 += delta * ((double)value - stats->mean);
+
+    if(value < stats->min)
+    {
+        stats->min = value;
+    }
+
+    if(value > stats->max)
+    {
+        stats->max = value;
+        stats->peak_timestamp = timestamp;
+    }
+}
+
+/*!	
+ * \brief Get results - RMS is derived from the mean and the population variance
+ *
+ * \param[in] stats Statistics
+ * \param[out] result Pointer to store results, all zero when there were no samples
+ * 
+ * \retval None
+ */
+void App_Statistics_GetResult(const App_Statistics_t* stats, App_Statistics_Result_t* result)
+{
+    double variance;
+
+    result->count = stats->count;
+
+    if(stats->count > 0U)
+    {
+        variance = stats->m2 / (double)stats->count;
+
+        result->min = stats->min;
+        result->max = stats->max;
+        result->mean = (int32_t)lround(stats->mean);
+        result->rms = (int32_t)lround(sqrt((stats->mean * stats->mean) + variance));
+        result->std_dev = (int32_t)lround(sqrt(variance));
+        result->peak_timestamp = stats->peak_timestamp;
+    }
+    else
+    {
+        result->min = 0;
+        result->max = 0;
+        result->mean = 0;
+        result->rms = 0;
+        result->std_dev = 0;
+        result->peak_timestamp = 0U;
+    }
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
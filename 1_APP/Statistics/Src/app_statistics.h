@@ -0,0 +1,65 @@
+#ifndef _APP_STATISTICS_H_
+#define _APP_STATISTICS_H_
+
+/* 
+ * Streaming statistics - samples are added one by one, the state does not depend on the number of
+ * samples. Mean and variance are computed with the Welford algorithm (numerically stable).
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Running state - App_Statistics_Reset before the first sample
+ */
+typedef struct 
+{
+    uint32_t count;
+    double mean;
+    double m2;                  /* Sum of squared differences from the mean */
+    int32_t min;
+    int32_t max;
+    uint64_t peak_timestamp;    /* Timestamp of the max */
+}App_Statistics_t;
+
+/*
+ * Results - same unit as the samples
+ */
+typedef struct 
+{
+    uint32_t count;
+    int32_t min;
+    int32_t max;
+    int32_t mean;
+    int32_t rms;
+    int32_t std_dev;
+    uint64_t peak_timestamp;
+}App_Statistics_Result_t;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void App_Statistics_Reset(App_Statistics_t* stats);
+void App_Statistics_Add(App_Statistics_t* stats, int32_t value, uint64_t timestamp);
+void App_Statistics_GetResult(const App_Statistics_t* stats, App_Statistics_Result_t* result);
+
+#endif  /* _APP_STATISTICS_H_ */
@@ -0,0 +1,146 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <string.h>
+#include "app_task_stats.h"
+#include "bench.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void App_TaskStats_Sort(TaskStatus_t* status, uint32_t num);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+#if (BENCH_ENABLE == 1U)
+static App_TaskStats_t App_TaskStats_Bench;
+#endif
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Update the statistics - load of the tasks since the previous update, all tasks since the
+ *        start on the first call. Counters wrap after ~21 min, the period should be shorter.
+ *
+ * \param[in,out] stats Statistics to update
+ * 
+ * \retval None
+ */
+void App_TaskStats_Update(App_TaskStats_t* stats)
+{
+    uint32_t number[APP_TASK_STATS_TASKS_MAX];
+    uint32_t counter[APP_TASK_STATS_TASKS_MAX];
+    uint32_t total = 0U;
+    uint32_t elapsed;
+    uint32_t delta;
+    uint32_t num;
+    uint32_t prev = 0U;
+    uint64_t load;
+
+    /* Scheduler suspended while the task lists are walked - O(tasks) */
+    num = (uint32_t)uxTaskGetSystemState(stats->status, APP_TASK_STATS_TASKS_MAX, &total);
+    elapsed = total - stats->total;
+
+    App_TaskStats_Sort(stats->status, num);
+
+    for(uint32_t i = 0U; i < num; i++)
+    {
+        const TaskStatus_t* status = &stats->status[i];
+        App_TaskStats_Task_t* task = &stats->task[i];
+
+        number[i] = (uint32_t)status->xTaskNumber;
+        counter[i] = status->ulRunTimeCounter;
+        delta = counter[i];
+
+        /* Both lists are ordered by the task number - a new task has run since its creation */
+        while((prev < stats->num) && (stats->task[prev].number < number[i]))
+        {
+            prev++;
+        }
+
+        if((prev < stats->num) && (stats->task[prev].number == number[i]))
+        {
+            delta -= stats->counter[prev];
+        }
+
+        load = (elapsed > 0U) ? (((uint64_t)delta * APP_TASK_STATS_LOAD_FULL) / elapsed) : 0U;
+
+        (void)strncpy(task->name, status->pcTaskName, APP_TASK_STATS_NAME_LEN - 1U);
+        task->name[APP_TASK_STATS_NAME_LEN - 1U] = '\0';
+        task->load = (uint16_t)((load > APP_TASK_STATS_LOAD_FULL) ? APP_TASK_STATS_LOAD_FULL : load);
+        task->stack = (uint16_t)status->usStackHighWaterMark;
+    }
+
+    /* Task numbers are read above before the entries are overwritten */
+    for(uint32_t i = 0U; i < num; i++)
+    {
+        stats->task[i].number = number[i];
+        stats->counter[i] = counter[i];
+    }
+
+    stats->num = num;
+    stats->total = total;
+}
+
+#if (BENCH_ENABLE == 1U)
+/*!	
+ * \brief Benchmark of the statistics update - own state, the reports are not affected
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_TaskStats_BenchUpdate(void)
+{
+    App_TaskStats_Update(&App_TaskStats_Bench);
+}
+#endif
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Sort the task states by the task number - insertion sort, the list is short and mostly
+ *        ordered already
+ *
+ * \param[in,out] status Task states
+ * \param[in] num Number of the task states
+ * 
+ * \retval None
+ */
+static void App_TaskStats_Sort(TaskStatus_t* status, uint32_t num)
+{
+    TaskStatus_t key;
+    uint32_t j;
+
+    for(uint32_t i = 1U; i < num; i++)
+    {
+        key = status[i];
+
+        for(j = i; (j > 0U) && (status[j - 1U].xTaskNumber > key.xTaskNumber); j--)
+        {
+            status[j] = status[j - 1U];
+        }
+
+        status[j] = key;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef _APP_TASK_STATS_H_
+#define _APP_TASK_STATS_H_
+
+/*
+ * Task statistics - CPU load of every task over the period since the previous update and the stack
+ * high-water mark. Run time is counted by FreeRTOS on every context switch from the DWT cycle counter
+ * (configGENERATE_RUN_TIME_STATS, see freertos.c), so the load of the IDLE task is the CPU headroom.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include "cmsis_os.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_TASK_STATS_TASKS_MAX        (16U)       /* Including IDLE and the timer task */
+#define APP_TASK_STATS_NAME_LEN         (16U)       /* configMAX_TASK_NAME_LEN */
+#define APP_TASK_STATS_LOAD_FULL        (10000U)    /* Load of a task running all the period - 100.00 % */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Statistics of one task
+ */
+typedef struct
+{
+    char name[APP_TASK_STATS_NAME_LEN];
+    uint32_t number;            /* FreeRTOS task number - order of creation */
+    uint16_t load;              /* 0.01 % of the period */
+    uint16_t stack;             /* Min free stack since the task start in words */
+}App_TaskStats_Task_t;
+
+/*
+ * Statistics of all tasks and the state of the previous update - every user keeps its own
+ */
+typedef struct
+{
+    App_TaskStats_Task_t task[APP_TASK_STATS_TASKS_MAX];    /* Ordered by the task number */
+    uint32_t num;
+    uint32_t total;                                         /* Run time counter of the previous update */
+    uint32_t counter[APP_TASK_STATS_TASKS_MAX];             /* Task run time of the previous update */
+    TaskStatus_t status[APP_TASK_STATS_TASKS_MAX];          /* Working buffer */
+}App_TaskStats_t;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void App_TaskStats_Update(App_TaskStats_t* stats);
+
+/*
+ * Benchmarks - BENCH_ENABLE build only
+ */
+void App_TaskStats_BenchUpdate(void);
+
+#endif  /* _APP_TASK_STATS_H_ */
@@ -0,0 +1,580 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <string.h>
+#include "app_telemetry.h"
+#include "bench.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_TELEMETRY_NS_IN_US          (1000U)
+
+#define APP_TELEMETRY_CRC_INIT          (0xFFFFU)
+#define APP_TELEMETRY_CRC_POLY          (0x1021U)
+
+#define APP_TELEMETRY_POS_ALERT         (4U)
+#define APP_TELEMETRY_POS_TYPE          (5U)
+
+#define APP_TELEMETRY_POS_KEYFRAME      (4U)
+#define APP_TELEMETRY_POS_ENTRY_ALERT   (5U)
+
+#define APP_TELEMETRY_BLOCK_HEADER_LEN  (5U)
+#define APP_TELEMETRY_POS_BLOCK_LOST    (3U)        /* Offset of the lost samples in the block header */
+#define APP_TELEMETRY_CRC_LEN           (2U)
+
+/* Sample set of the benchmarks - 4 channels sampled periodically with a few us of jitter and small changes */
+#define APP_TELEMETRY_BENCH_CHANNELS    (4U)
+#define APP_TELEMETRY_BENCH_SAMPLES_NUM (32U)
+#define APP_TELEMETRY_BENCH_PERIOD_NS   (1100000U)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static uint32_t App_Telemetry_Put16(uint8_t* buf, uint16_t value);
+static uint32_t App_Telemetry_Put32(uint8_t* buf, uint32_t value);
+static uint16_t App_Telemetry_Crc16(const uint8_t* data, uint32_t size);
+static uint32_t App_Telemetry_Cobs(uint8_t* frame, const uint8_t* data, uint32_t size);
+static uint32_t App_Telemetry_PutVarint(uint8_t* buf, int32_t value);
+#if (BENCH_ENABLE == 1U)
+static const Hal_EnergyMonitor_Sample_t* App_Telemetry_BenchSample(void);
+#endif
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+_Static_assert(APP_TELEMETRY_RECORD_LEN < 254U, "COBS with one code byte requires records shorter than 254 bytes");
+_Static_assert(APP_TELEMETRY_TASK_RECORD_LEN == (13U + APP_TASK_STATS_NAME_LEN), "Task record layout");
+_Static_assert(APP_TELEMETRY_TRACE_LEN < 254U, "COBS with one code byte requires trace frames shorter than 254 bytes");
+_Static_assert(APP_TELEMETRY_BLOCK_LEN < 254U, "COBS with one code byte requires blocks shorter than 254 bytes");
+_Static_assert((APP_TELEMETRY_TEXT_MAX_LEN + 3U) < 254U, "COBS with one code byte requires log lines shorter than 251 bytes");
+_Static_assert(HAL_ENERGY_MONITOR_CHANNELS_NUM <= APP_TELEMETRY_CHANNELS_MAX, "Channel does not fit in the entry tag");
+_Static_assert(APP_TASK_STATS_TASKS_MAX <= 16U, "Task index does not fit in the header");
+
+#if (BENCH_ENABLE == 1U)
+static Hal_EnergyMonitor_Sample_t App_Telemetry_BenchSamples[APP_TELEMETRY_BENCH_SAMPLES_NUM];
+static uint32_t App_Telemetry_BenchIndex;
+static App_Telemetry_Stream_t App_Telemetry_BenchStream;   /* Filled sample by sample */
+static App_Telemetry_Stream_t App_Telemetry_BenchBlock;    /* Full block, closed again every run */
+static uint8_t App_Telemetry_BenchFrame[APP_TELEMETRY_BLOCK_FRAME_MAX_LEN];
+static volatile uint32_t App_Telemetry_BenchSink;      /* Keeps the benchmarked frame length */
+#endif
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Encode sample into framed telemetry record
+ *
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_FRAME_MAX_LEN bytes
+ * \param[in] sample Sample to encode
+ * \param[in] sequence Sequence number of the record
+ * \param[in] alert Alert status
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeSample(uint8_t* frame, const Hal_EnergyMonitor_Sample_t* sample, uint16_t sequence, bool alert)
+{
+    uint8_t record[APP_TELEMETRY_RECORD_LEN];
+    uint32_t len = 0U;
+
+    record[len++] = (uint8_t)((sample->channel & 0x0FU) | ((alert ? 1U : 0U) << APP_TELEMETRY_POS_ALERT) | \
+                              (APP_TELEMETRY_TYPE_RECORD << APP_TELEMETRY_POS_TYPE));
+    len += App_Telemetry_Put16(&record[len], sequence);
+    len += App_Telemetry_Put32(&record[len], (uint32_t)(sample->timestamp / APP_TELEMETRY_NS_IN_US));
+    len += App_Telemetry_Put32(&record[len], (uint32_t)sample->bus_voltage);
+    len += App_Telemetry_Put32(&record[len], (uint32_t)sample->current);
+    len += App_Telemetry_Put32(&record[len], (uint32_t)sample->power);
+    len += App_Telemetry_Put16(&record[len], App_Telemetry_Crc16(record, len));
+
+    return App_Telemetry_Cobs(frame, record, len);
+}
+
+/*!	
+ * \brief Encode statistics of one task into framed telemetry record
+ *
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_TASK_FRAME_MAX_LEN bytes
+ * \param[in] task Task statistics
+ * \param[in] index Index of the task in the report
+ * \param[in] sequence Sequence number of the report
+ * \param[in] timestamp Time of the report in ns
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeTask(uint8_t* frame, const App_TaskStats_Task_t* task, uint8_t index, uint16_t sequence, uint64_t timestamp)
+{
+    uint8_t record[APP_TELEMETRY_TASK_RECORD_LEN];
+    uint32_t len = 0U;
+
+    record[len++] = (uint8_t)((index & 0x0FU) | (APP_TELEMETRY_TYPE_TASK << APP_TELEMETRY_POS_TYPE));
+    len += App_Telemetry_Put16(&record[len], sequence);
+    len += App_Telemetry_Put32(&record[len], (uint32_t)(timestamp / APP_TELEMETRY_NS_IN_US));
+    len += App_Telemetry_Put16(&record[len], task->load);
+    len += App_Telemetry_Put16(&record[len], task->stack);
+    (void)strncpy((char*)&record[len], task->name, APP_TASK_STATS_NAME_LEN);
+    len += APP_TASK_STATS_NAME_LEN;
+    len += App_Telemetry_Put16(&record[len], App_Telemetry_Crc16(record, len));
+
+    return App_Telemetry_Cobs(frame, record, len);
+}
+
+/*!	
+ * \brief Start new compressed stream block
+ *
+ * \param[in] stream Stream state
+ * 
+ * \retval None
+ */
+void App_Telemetry_StreamBegin(App_Telemetry_Stream_t* stream)
+{
+    stream->len = 0U;
+    stream->lost = 0U;
+    stream->channels = 0U;
+
+    stream->block[stream->len++] = (uint8_t)(APP_TELEMETRY_TYPE_STREAM << APP_TELEMETRY_POS_TYPE);
+    stream->len += App_Telemetry_Put16(&stream->block[stream->len], stream->sequence);
+    stream->len += App_Telemetry_Put16(&stream->block[stream->len], 0U);   /* Lost samples, set by App_Telemetry_StreamEnd */
+}
+
+/*!	
+ * \brief Add sample to the stream block - at most APP_TELEMETRY_ENTRY_MAX_LEN bytes and a fixed
+ *        number of steps per sample
+ *
+ * \param[in] stream Stream state
+ * \param[in] sample Sample to add
+ * \param[in] lost Samples lost just before this one
+ * \param[in] alert Alert status
+ * 
+ * \retval True if added, false if the block is full or the samples were lost after its first sample
+ *         (the sample should be added to the next one)
+ */
+bool App_Telemetry_StreamAdd(App_Telemetry_Stream_t* stream, const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost, bool alert)
+{
+    uint8_t channel = sample->channel & 0x0FU;
+    uint32_t time = (uint32_t)(sample->timestamp / APP_TELEMETRY_NS_IN_US);
+    uint8_t* entry = &stream->block[stream->len];
+    uint32_t len = 1U;
+    int32_t step;
+    bool ret_val = false;
+
+    if(((lost == 0U) || (stream->len == APP_TELEMETRY_BLOCK_HEADER_LEN)) && \
+       ((stream->len + APP_TELEMETRY_ENTRY_MAX_LEN + APP_TELEMETRY_CRC_LEN) <= APP_TELEMETRY_BLOCK_LEN))
+    {
+        if(lost > 0U)
+        {
+            /* First sample of the block */
+            stream->lost = (lost < UINT16_MAX) ? (uint16_t)lost : UINT16_MAX;
+        }
+
+        entry[0] = (uint8_t)(channel | ((alert ? 1U : 0U) << APP_TELEMETRY_POS_ENTRY_ALERT));
+
+        if((stream->channels & (1U << channel)) == 0U)
+        {
+            /* Keyframe - every block can be decoded without the previous ones */
+            entry[0] |= (uint8_t)(1U << APP_TELEMETRY_POS_KEYFRAME);
+            len += App_Telemetry_Put32(&entry[len], time);
+            len += App_Telemetry_PutVarint(&entry[len], sample->bus_voltage);
+            len += App_Telemetry_PutVarint(&entry[len], sample->current);
+            len += App_Telemetry_PutVarint(&entry[len], sample->power);
+
+            stream->step[channel] = 0;
+            stream->channels |= (uint16_t)(1U << channel);
+        }
+        else
+        {
+            /* Sampling is periodic, so the change of the time step is close to zero as well */
+            step = (int32_t)(time - stream->time[channel]);
+            len += App_Telemetry_PutVarint(&entry[len], (int32_t)((uint32_t)step - (uint32_t)stream->step[channel]));
+            len += App_Telemetry_PutVarint(&entry[len], (int32_t)((uint32_t)sample->bus_voltage - (uint32_t)stream->bus_voltage[channel]));
+            len += App_Telemetry_PutVarint(&entry[len], (int32_t)((uint32_t)sample->current - (uint32_t)stream->current[channel]));
+            len += App_Telemetry_PutVarint(&entry[len], (int32_t)((uint32_t)sample->power - (uint32_t)stream->power[channel]));
+
+            stream->step[channel] = step;
+        }
+
+        stream->time[channel] = time;
+        stream->bus_voltage[channel] = sample->bus_voltage;
+        stream->current[channel] = sample->current;
+        stream->power[channel] = sample->power;
+        stream->len += len;
+
+        ret_val = true;
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Close the stream block - adds CRC and COBS framing
+ *
+ * \param[in] stream Stream state
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_BLOCK_FRAME_MAX_LEN bytes
+ * 
+ * \retval Frame length including the delimiter, 0 if the block has no samples
+ */
+uint32_t App_Telemetry_StreamEnd(App_Telemetry_Stream_t* stream, uint8_t* frame)
+{
+    uint32_t ret_val = 0U;
+
+    if(stream->len > APP_TELEMETRY_BLOCK_HEADER_LEN)
+    {
+        (void)App_Telemetry_Put16(&stream->block[APP_TELEMETRY_POS_BLOCK_LOST], stream->lost);
+        stream->len += App_Telemetry_Put16(&stream->block[stream->len], App_Telemetry_Crc16(stream->block, stream->len));
+        ret_val = App_Telemetry_Cobs(frame, stream->block, stream->len);
+        stream->sequence++;
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Encode trace dump info into framed telemetry
+ *
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_TRACE_FRAME_MAX_LEN bytes
+ * \param[in] clock Core clock in Hz - unit of the event timestamps
+ * \param[in] written Events recorded since start-up
+ * \param[in] kept Events kept by the buffer
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeTraceInfo(uint8_t* frame, uint32_t clock, uint32_t written, uint32_t kept)
+{
+    uint8_t data[APP_TELEMETRY_TRACE_LEN];
+    uint32_t len = 0U;
+
+    data[len++] = (uint8_t)(APP_TELEMETRY_TRACE_INFO | (APP_TELEMETRY_TYPE_TRACE << APP_TELEMETRY_POS_TYPE));
+    len += App_Telemetry_Put32(&data[len], clock);
+    len += App_Telemetry_Put32(&data[len], written);
+    len += App_Telemetry_Put32(&data[len], kept);
+    len += App_Telemetry_Put16(&data[len], App_Telemetry_Crc16(data, len));
+
+    return App_Telemetry_Cobs(frame, data, len);
+}
+
+/*!	
+ * \brief Encode name of a task or interrupt of the trace dump into framed telemetry
+ *
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_TRACE_FRAME_MAX_LEN bytes
+ * \param[in] source APP_TELEMETRY_TRACE_NAME_TASK or APP_TELEMETRY_TRACE_NAME_ISR
+ * \param[in] id Task number or interrupt id
+ * \param[in] name Name, truncated to APP_TELEMETRY_TRACE_NAME_LEN characters
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeTraceName(uint8_t* frame, uint8_t source, uint8_t id, const char* name)
+{
+    uint8_t data[APP_TELEMETRY_TRACE_LEN];
+    uint32_t len = 0U;
+
+    data[len++] = (uint8_t)(APP_TELEMETRY_TRACE_NAME | (APP_TELEMETRY_TYPE_TRACE << APP_TELEMETRY_POS_TYPE));
+    data[len++] = source;
+    data[len++] = id;
+    (void)strncpy((char*)&data[len], name, APP_TELEMETRY_TRACE_NAME_LEN);
+    len += APP_TELEMETRY_TRACE_NAME_LEN;
+    len += App_Telemetry_Put16(&data[len], App_Telemetry_Crc16(data, len));
+
+    return App_Telemetry_Cobs(frame, data, len);
+}
+
+/*!	
+ * \brief Encode trace events into framed telemetry
+ *
+ * \param[out] frame Output buffer, at least APP_TELEMETRY_TRACE_FRAME_MAX_LEN bytes
+ * \param[in] events Events, oldest first
+ * \param[in] num Number of the events, at most APP_TELEMETRY_TRACE_EVENTS_MAX
+ * \param[in] sequence Sequence number of the frame in the dump
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeTraceEvents(uint8_t* frame, const Trace_Record_t* events, uint32_t num, uint16_t sequence)
+{
+    uint8_t data[APP_TELEMETRY_TRACE_LEN];
+    uint32_t len = 0U;
+
+    if(num > APP_TELEMETRY_TRACE_EVENTS_MAX)
+    {
+        num = APP_TELEMETRY_TRACE_EVENTS_MAX;
+    }
+
+    data[len++] = (uint8_t)(APP_TELEMETRY_TRACE_EVENTS | (APP_TELEMETRY_TYPE_TRACE << APP_TELEMETRY_POS_TYPE));
+    len += App_Telemetry_Put16(&data[len], sequence);
+
+    for(uint32_t i = 0; i < num; i++)
+    {
+        len += App_Telemetry_Put32(&data[len], events[i].timestamp);
+        data[len++] = events[i].event;
+        data[len++] = events[i].id;
+    }
+
+    len += App_Telemetry_Put16(&data[len], App_Telemetry_Crc16(data, len));
+
+    return App_Telemetry_Cobs(frame, data, len);
+}
+
+/*!	
+ * \brief Encode log line into framed telemetry
+ *
+ * \param[out] frame Output buffer, at least len + APP_TELEMETRY_TEXT_OVERHEAD bytes
+ * \param[in] text Line
+ * \param[in] len Line length, truncated to APP_TELEMETRY_TEXT_MAX_LEN characters
+ * 
+ * \retval Frame length including the delimiter
+ */
+uint32_t App_Telemetry_EncodeText(uint8_t* frame, const char* text, uint32_t len)
+{
+    uint8_t data[APP_TELEMETRY_TEXT_MAX_LEN + 3U];
+    uint32_t size = 0U;
+
+    len = (len < APP_TELEMETRY_TEXT_MAX_LEN) ? len : APP_TELEMETRY_TEXT_MAX_LEN;
+
+    data[size++] = (uint8_t)(APP_TELEMETRY_TYPE_TEXT << APP_TELEMETRY_POS_TYPE);
+    (void)memcpy(&data[size], text, len);
+    size += len;
+    size += App_Telemetry_Put16(&data[size], App_Telemetry_Crc16(data, size));
+
+    return App_Telemetry_Cobs(frame, data, size);
+}
+
+#if (BENCH_ENABLE == 1U)
+/*!	
+ * \brief Benchmark of the sample record - the next sample of the set per run, nothing is transmitted
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Telemetry_BenchEncodeSample(void)
+{
+    App_Telemetry_BenchSink = App_Telemetry_EncodeSample(App_Telemetry_BenchFrame, App_Telemetry_BenchSample(), 0U, false);
+}
+
+/*!	
+ * \brief Benchmark of the stream entry - the next sample of the set per run, a full block is
+ *        restarted (once per ~30 runs)
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Telemetry_BenchStreamAdd(void)
+{
+    const Hal_EnergyMonitor_Sample_t* sample = App_Telemetry_BenchSample();
+
+    if((App_Telemetry_BenchStream.len == 0U) || !App_Telemetry_StreamAdd(&App_Telemetry_BenchStream, sample, 0U, false))
+    {
+        App_Telemetry_StreamBegin(&App_Telemetry_BenchStream);
+        (void)App_Telemetry_StreamAdd(&App_Telemetry_BenchStream, sample, 0U, false);
+    }
+}
+
+/*!	
+ * \brief Benchmark of the stream block end - CRC and COBS of a block filled with the sample set,
+ *        the block is reopened after every run
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void App_Telemetry_BenchStreamEnd(void)
+{
+    uint32_t len;
+
+    if(App_Telemetry_BenchBlock.len == 0U)
+    {
+        App_Telemetry_StreamBegin(&App_Telemetry_BenchBlock);
+
+        while(App_Telemetry_StreamAdd(&App_Telemetry_BenchBlock, App_Telemetry_BenchSample(), 0U, false))
+        {
+        }
+    }
+
+    len = App_Telemetry_BenchBlock.len;
+    App_Telemetry_BenchSink = App_Telemetry_StreamEnd(&App_Telemetry_BenchBlock, App_Telemetry_BenchFrame);
+    App_Telemetry_BenchBlock.len = len;
+}
+#endif
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Store 16-bit value, little-endian
+ *
+ * \param[out] buf Output position
+ * \param[in] value Value to store
+ * 
+ * \retval Number of written bytes
+ */
+static uint32_t App_Telemetry_Put16(uint8_t* buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8U);
+
+    return 2U;
+}
+
+/*!	
+ * \brief Store 32-bit value, little-endian
+ *
+ * \param[out] buf Output position
+ * \param[in] value Value to store
+ * 
+ * \retval Number of written bytes
+ */
+static uint32_t App_Telemetry_Put32(uint8_t* buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8U);
+    buf[2] = (uint8_t)(value >> 16U);
+    buf[3] = (uint8_t)(value >> 24U);
+
+    return 4U;
+}
+
+/*!	
+ * \brief CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no final XOR)
+ *
+ * \param[in] data Data
+ * \param[in] size Data size
+ * 
+ * \retval CRC
+ */
+static uint16_t App_Telemetry_Crc16(const uint8_t* data, uint32_t size)
+{
+    uint16_t crc = APP_TELEMETRY_CRC_INIT;
+
+    for(uint32_t i = 0; i < size; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8U);
+
+        for(uint8_t bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ APP_TELEMETRY_CRC_POLY) : (uint16_t)(crc << 1U);
+        }
+    }
+
+    return crc;
+}
+
+/*!	
+ * \brief Consistent Overhead Byte Stuffing - removes zeros from the data and adds the 0x00 delimiter.
+ *        Data shorter than 254 bytes, so one code byte of overhead.
+ *
+ * \param[out] frame Output buffer, size + 2 bytes
+ * \param[in] data Data to encode
+ * \param[in] size Data size
+ * 
+ * \retval Frame length including the delimiter
+ */
+static uint32_t App_Telemetry_Cobs(uint8_t* frame, const uint8_t* data, uint32_t size)
+{
+    uint32_t code_pos = 0U;
+    uint32_t len = 1U;
+    uint8_t code = 1U;
+
+    for(uint32_t i = 0; i < size; i++)
+    {
+        if(data[i] == 0U)
+        {
+            frame[code_pos] = code;
+            code_pos = len++;
+            code = 1U;
+        }
+        else
+        {
+            frame[len++] = data[i];
+            code++;
+        }
+    }
+
+    frame[code_pos] = code;
+    frame[len++] = 0U;
+
+    return len;
+}
+
+/*!	
+ * \brief Store signed value as zig-zag LEB128 varint - small magnitudes take one byte
+ *
+ * \param[out] buf Output position, at least 5 bytes
+ * \param[in] value Value to store
+ * 
+ * \retval Number of written bytes
+ */
+static uint32_t App_Telemetry_PutVarint(uint8_t* buf, int32_t value)
+{
+    uint32_t zigzag = ((uint32_t)value << 1U) ^ (uint32_t)(value >> 31);
+    uint32_t len = 0U;
+
+    while(zigzag >= 0x80U)
+    {
+        buf[len++] = (uint8_t)(zigzag | 0x80U);
+        zigzag >>= 7U;
+    }
+
+    buf[len++] = (uint8_t)zigzag;
+
+    return len;
+}
+
+#if (BENCH_ENABLE == 1U)
+/*!	
+ * \brief Get the next sample of the benchmark set - the set is generated by the first call (warm-up run)
+ *        and moved forward in time after every pass, so the stream deltas stay periodic
+ *
+ * \param[in] None
+ * 
+ * \retval Sample
+ */
+static const Hal_EnergyMonitor_Sample_t* App_Telemetry_BenchSample(void)
+{
+    Hal_EnergyMonitor_Sample_t* sample;
+
+    if(App_Telemetry_BenchSamples[0].sequence == 0U)
+    {
+        for(uint32_t i = 0U; i < APP_TELEMETRY_BENCH_SAMPLES_NUM; i++)
+        {
+            sample = &App_Telemetry_BenchSamples[i];
+            sample->channel = (uint8_t)(i % APP_TELEMETRY_BENCH_CHANNELS);
+            sample->sequence = (i / APP_TELEMETRY_BENCH_CHANNELS) + 1U;
+            sample->timestamp = ((uint64_t)sample->sequence * APP_TELEMETRY_BENCH_PERIOD_NS) + \
+                                ((i * 7919U) % 4000U);                              /* Up to 4 us of jitter */
+            sample->bus_voltage = 3300000 + (int32_t)((i * 211U) % 800U);           /* uV */
+            sample->current = (20000 * (int32_t)(sample->channel + 1U)) + (int32_t)((i * 97U) % 300U);   /* uA */
+            sample->power = (int32_t)(((int64_t)sample->bus_voltage * sample->current) / 1000000);        /* uW */
+        }
+    }
+
+    else if(App_Telemetry_BenchIndex == 0U)
+    {
+        for(uint32_t i = 0U; i < APP_TELEMETRY_BENCH_SAMPLES_NUM; i++)
+        {
+            App_Telemetry_BenchSamples[i].timestamp += (uint64_t)(APP_TELEMETRY_BENCH_SAMPLES_NUM / APP_TELEMETRY_BENCH_CHANNELS) * \
+                                                       APP_TELEMETRY_BENCH_PERIOD_NS;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    sample = &App_Telemetry_BenchSamples[App_Telemetry_BenchIndex];
+    App_Telemetry_BenchIndex = (App_Telemetry_BenchIndex + 1U) % APP_TELEMETRY_BENCH_SAMPLES_NUM;
+
+    return sample;
+}
+#endif
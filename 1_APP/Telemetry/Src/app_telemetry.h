@@ -0,0 +1,165 @@
+#ifndef _APP_TELEMETRY_H_
+#define _APP_TELEMETRY_H_
+
+/* 
+ * Binary telemetry, all fixed-size fields little-endian. Frame type is given by bits 5-7 of the first byte.
+ *
+ * Record of one sample (type 1):
+ *
+ *  Offset  Size  Field
+ *  0       1     Header - bits 0-3 channel, bit 4 alert status, bits 5-7 type
+ *  1       2     Sequence number of the record (wraps)
+ *  3       4     Acquisition time in us (wraps after ~71 min)
+ *  7       4     Bus voltage in uV (int32)
+ *  11      4     Current in uA (int32)
+ *  15      4     Power in uW (int32)
+ *  19      2     CRC-16/CCITT-FALSE of bytes 0-18
+ *
+ * Compressed stream block (type 2) - samples of any channels, the block is decoded on its own:
+ *
+ *  Size    Field
+ *  1       Header - bits 5-7 type
+ *  2       Sequence number of the block (wraps)
+ *  2       Samples lost just before the first sample of the block (saturates) - overwritten in the
+ *          HAL history before they were read, a block never spans a gap
+ *  n       Entries
+ *  2       CRC-16/CCITT-FALSE of all bytes before
+ *
+ *  Entry - first sample of a channel in the block is a keyframe, the next ones are deltas to the previous
+ *  sample of the channel. Varints are LEB128, signed values zig-zag encoded.
+ *  1       Tag - bits 0-3 channel, bit 4 keyframe, bit 5 alert status
+ *          Keyframe: time in us (4 bytes), voltage, current, power (signed varints)
+ *          Delta: change of the time step in us, change of voltage, current, power (signed varints)
+ *
+ * Task statistics record (type 3) - one per task, sent every APP_ENERGY_MONITOR_TASK_STATS_PERIOD:
+ *
+ *  Offset  Size  Field
+ *  0       1     Header - bits 0-3 index of the task in the report, bits 5-7 type
+ *  1       2     Sequence number of the report (wraps)
+ *  3       4     Time of the report in us (wraps after ~71 min)
+ *  7       2     CPU load in 0.01 % of the report period - IDLE is the headroom
+ *  9       2     Stack high-water mark in words
+ *  11      16    Task name, '\0' padded
+ *  27      2     CRC-16/CCITT-FALSE of bytes 0-26
+ *
+ * Trace dump (type 4) - sent by the "trace" command: info, names of the tasks and interrupts, events:
+ *
+ *  Size    Field
+ *  1       Header - bits 0-3 kind, bits 5-7 type
+ *          Info (kind 0): core clock in Hz (4 bytes), events recorded since start-up (4 bytes), events
+ *          kept by the buffer (4 bytes) - the older ones are lost
+ *          Name (kind 1): source - 0 task, 1 interrupt (1 byte), task number or interrupt id (1 byte),
+ *          name '\0' padded (16 bytes)
+ *          Events (kind 2): sequence number of the frame in the dump (2 bytes), up to
+ *          APP_TELEMETRY_TRACE_EVENTS_MAX events, oldest first - lower 32 bits of the cycle counter
+ *          (4 bytes), event - Trace_Event_t (1 byte), task number or interrupt id (1 byte)
+ *  2       CRC-16/CCITT-FALSE of all bytes before
+ *
+ * Log line (type 5) - text of the log while a binary format is selected:
+ *
+ *  Size    Field
+ *  1       Header - bits 5-7 type
+ *  n       Text of the line, up to APP_TELEMETRY_TEXT_MAX_LEN characters, CR LF included
+ *  2       CRC-16/CCITT-FALSE of all bytes before
+ *
+ * Frames are COBS encoded and terminated with 0x00, so a receiver synchronizes on any zero byte. Every
+ * write of frames to the UART starts with 0x00 as well - text written in between ends in its own (invalid)
+ * frame instead of corrupting the next one.
+ * Decoder: Tools/telemetry_decoder.py
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "hal_energy_monitor.h"
+#include "app_task_stats.h"
+#include "trace.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define APP_TELEMETRY_TYPE_RECORD       (1U)
+#define APP_TELEMETRY_TYPE_STREAM       (2U)
+#define APP_TELEMETRY_TYPE_TASK         (3U)
+#define APP_TELEMETRY_TYPE_TRACE        (4U)
+#define APP_TELEMETRY_TYPE_TEXT         (5U)
+
+#define APP_TELEMETRY_RECORD_LEN        (21U)
+#define APP_TELEMETRY_FRAME_MAX_LEN     (APP_TELEMETRY_RECORD_LEN + 2U)     /* COBS code byte and delimiter */
+
+#define APP_TELEMETRY_TASK_RECORD_LEN   (29U)
+#define APP_TELEMETRY_TASK_FRAME_MAX_LEN    (APP_TELEMETRY_TASK_RECORD_LEN + 2U)
+
+#define APP_TELEMETRY_TRACE_INFO        (0U)                                /* Trace dump frame kinds */
+#define APP_TELEMETRY_TRACE_NAME        (1U)
+#define APP_TELEMETRY_TRACE_EVENTS      (2U)
+#define APP_TELEMETRY_TRACE_NAME_TASK   (0U)                                /* Sources of the names */
+#define APP_TELEMETRY_TRACE_NAME_ISR    (1U)
+#define APP_TELEMETRY_TRACE_NAME_LEN    (16U)
+#define APP_TELEMETRY_TRACE_EVENTS_MAX  (40U)                               /* Events in one frame */
+#define APP_TELEMETRY_TRACE_EVENT_LEN   (6U)
+#define APP_TELEMETRY_TRACE_LEN         (5U + (APP_TELEMETRY_TRACE_EVENTS_MAX * APP_TELEMETRY_TRACE_EVENT_LEN))
+#define APP_TELEMETRY_TRACE_FRAME_MAX_LEN   (APP_TELEMETRY_TRACE_LEN + 2U)  /* COBS code byte and delimiter */
+
+#define APP_TELEMETRY_TEXT_MAX_LEN      (200U)                              /* Characters of one log line */
+#define APP_TELEMETRY_TEXT_OVERHEAD     (5U)                                /* Header, CRC, COBS code byte and delimiter */
+
+#define APP_TELEMETRY_CHANNELS_MAX      (16U)
+#define APP_TELEMETRY_BLOCK_LEN         (240U)                              /* Stream block without COBS */
+#define APP_TELEMETRY_ENTRY_MAX_LEN     (21U)                               /* Tag and 4 varints of 5 bytes */
+#define APP_TELEMETRY_BLOCK_FRAME_MAX_LEN   (APP_TELEMETRY_BLOCK_LEN + 2U)  /* COBS code byte and delimiter */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Compressed stream encoder state
+ */
+typedef struct 
+{
+    uint8_t block[APP_TELEMETRY_BLOCK_LEN];
+    uint32_t len;
+    uint16_t sequence;
+    uint16_t lost;                                  /* Samples lost before the block */
+    uint16_t channels;                              /* Channels with a keyframe in the block, bit per channel */
+    uint32_t time[APP_TELEMETRY_CHANNELS_MAX];      /* us - previous sample */
+    int32_t step[APP_TELEMETRY_CHANNELS_MAX];       /* us - previous time step */
+    int32_t bus_voltage[APP_TELEMETRY_CHANNELS_MAX];
+    int32_t current[APP_TELEMETRY_CHANNELS_MAX];
+    int32_t power[APP_TELEMETRY_CHANNELS_MAX];
+}App_Telemetry_Stream_t;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+uint32_t App_Telemetry_EncodeSample(uint8_t* frame, const Hal_EnergyMonitor_Sample_t* sample, uint16_t sequence, bool alert);
+uint32_t App_Telemetry_EncodeTask(uint8_t* frame, const App_TaskStats_Task_t* task, uint8_t index, uint16_t sequence, uint64_t timestamp);
+void App_Telemetry_StreamBegin(App_Telemetry_Stream_t* stream);
+bool App_Telemetry_StreamAdd(App_Telemetry_Stream_t* stream, const Hal_EnergyMonitor_Sample_t* sample, uint32_t lost, bool alert);
+uint32_t App_Telemetry_StreamEnd(App_Telemetry_Stream_t* stream, uint8_t* frame);
+uint32_t App_Telemetry_EncodeTraceInfo(uint8_t* frame, uint32_t clock, uint32_t written, uint32_t kept);
+uint32_t App_Telemetry_EncodeTraceName(uint8_t* frame, uint8_t source, uint8_t id, const char* name);
+uint32_t App_Telemetry_EncodeTraceEvents(uint8_t* frame, const Trace_Record_t* events, uint32_t num, uint16_t sequence);
+uint32_t App_Telemetry_EncodeText(uint8_t* frame, const char* text, uint32_t len);
+
+/*
+ * Benchmarks - BENCH_ENABLE build only
+ */
+void App_Telemetry_BenchEncodeSample(void);
+void App_Telemetry_BenchStreamAdd(void);
+void App_Telemetry_BenchStreamEnd(void);
+
+#endif  /* _APP_TELEMETRY_H_ */
@@ -5,13 +5,52 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include "ina226_cfg.h"
+
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
-#define HAL_ENERGY_MONITOR_BUS_VOLTAGE_LSB      (1.25f)         /* mV */
-#define HAL_ENERGY_MONITOR_POWER_LSB            (0.00078125f)   /* W */
-#define HAL_ENERGY_MONITOR_CURRENT_LSB          (0.00003125f)   /* A */
+/* LSBs of the results - taken from the sensor configuration, see ina226_cfg.h. All conversions are integer. */
+#define HAL_ENERGY_MONITOR_BUS_VOLTAGE_LSB_UV       (INA226_BUS_VOLTAGE_LSB_UV)                                 /* uV */
+#define HAL_ENERGY_MONITOR_CURRENT_LSB_NA           ((int64_t)INA226_CFG_CURRENT_LSB_NA)                        /* nA */
+#define HAL_ENERGY_MONITOR_POWER_LSB_NW             ((int64_t)INA226_CFG_POWER_LSB_NW)                          /* nW */
+
+/*
+ * Shunt mode - only SHUNT_VOLTAGE and BUS_VOLTAGE are read, current and power are computed on the MCU.
+ * Halves bus traffic per sample and gives finer power resolution than the POWER register.
+ * For >1 kHz sampling use it with conversion ready mode and short conversion times (see ina226_cfg.h).
+ */
+#define HAL_ENERGY_MONITOR_SHUNT_MODE               (0U)
+#define HAL_ENERGY_MONITOR_SHUNT_VOLTAGE_LSB_NV     (INA226_SHUNT_VOLTAGE_LSB_NV)                               /* nV */
+#define HAL_ENERGY_MONITOR_SHUNT_RESISTANCE_MOHM    ((int32_t)(INA226_CFG_SHUNT_RESISTANCE_UOHM / 1000ULL))     /* mOhm */
+
+#define HAL_ENERGY_MONITOR_PERIOD               (50U)           /* ms - every channel is sampled once per period */
+#define HAL_ENERGY_MONITOR_INIT_TIMEOUT         (10U)           /* ms - max time of one register write during initialization */
+#define HAL_ENERGY_MONITOR_INTEGRATION_GAP      (1000U)         /* ms - longer intervals between samples are not integrated (data lost) */
+#define HAL_ENERGY_MONITOR_HISTORY_LEN          (64U)           /* Samples kept for Hal_EnergyMonitor_ReadBatch, power of 2, the reader is signalled at half-full */
+
+/*
+ * Conversion ready mode - channels are read once per fresh conversion signalled on the ALERT pin
+ * instead of every HAL_ENERGY_MONITOR_PERIOD. Requires INA226_CFG_MASK_ENABLE_CNVR enabled.
+ * All devices should use the same conversion time and averaging.
+ */
+#define HAL_ENERGY_MONITOR_CNVR_MODE            (1U)
+#define HAL_ENERGY_MONITOR_CNVR_TIMEOUT         (150U)          /* ms - sweep anyway if no edge came (~2x conversion time) */
+
+/*
+ * Sequence timeout - derived from the worst case register sweep of one channel. A register read is
+ * a pointer write (address, register) and a read (address, 2 data bytes), 9 clocks per byte plus
+ * a start and a stop condition per transfer. Rounded up to ms, +1 tick for the partial first tick
+ * of the wait and +1 full tick of margin.
+ */
+#define HAL_ENERGY_MONITOR_I2C_CLOCK_HZ         (400000U)       /* Hz - fast mode, see hi2c1 Timing */
+#define HAL_ENERGY_MONITOR_REGISTER_READ_BITS   ((5U * 9U) + (2U * 2U))
+#define HAL_ENERGY_MONITOR_SEQUENCE_REGISTERS   (((HAL_ENERGY_MONITOR_CNVR_MODE == 1U) ? 1U : 0U) + \
+                                                 ((HAL_ENERGY_MONITOR_SHUNT_MODE == 1U) ? 2U : 3U))
+#define HAL_ENERGY_MONITOR_SEQUENCE_TIME_US     ((HAL_ENERGY_MONITOR_SEQUENCE_REGISTERS * HAL_ENERGY_MONITOR_REGISTER_READ_BITS * \
+                                                  1000000U) / HAL_ENERGY_MONITOR_I2C_CLOCK_HZ)
+#define HAL_ENERGY_MONITOR_SEQUENCE_TIMEOUT     (((HAL_ENERGY_MONITOR_SEQUENCE_TIME_US + 999U) / 1000U) + 2U)    /* ms */
 
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
@@ -2,36 +2,91 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include <string.h>
 #include "hal_energy_monitor.h"
 #include "hal_energy_monitor_cfg.h"
 #include "ina226.h"
+#include "hal_gpio.h"
 #include "cmsis_os.h"
+#include "snapshot.h"
+#include "dwt.h"
+#include "log.h"
+#include "bench.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
+/* Worst case time needed to read all channels, the rest of the period is spent waiting */
+#define HAL_ENERGY_MONITOR_SWEEP_TIME       (HAL_ENERGY_MONITOR_SEQUENCE_TIMEOUT * HAL_ENERGY_MONITOR_CHANNELS_NUM)
+
+#define HAL_ENERGY_MONITOR_SIGNAL_DONE      (0x01)      /* Task signal - register sequence complete */
+
+#define HAL_ENERGY_MONITOR_NS_IN_US         (1000U)
+#define HAL_ENERGY_MONITOR_US_IN_MS         (1000U)
+#define HAL_ENERGY_MONITOR_PJ_IN_NWH        (3600000)   /* 1nWh = 3600000pJ, uW * us = pJ */
+#define HAL_ENERGY_MONITOR_PC_IN_NAH        (3600000)   /* 1nAh = 3600000pC, uA * us = pC */
+
+#define HAL_ENERGY_MONITOR_HISTORY_MASK     (HAL_ENERGY_MONITOR_HISTORY_LEN - 1U)
+#define HAL_ENERGY_MONITOR_HISTORY_HALF     (HAL_ENERGY_MONITOR_HISTORY_LEN / 2U)
+#define HAL_ENERGY_MONITOR_CACHE_LINE       (32U)       /* Cortex-M7 D-cache line */
+
+#define HAL_ENERGY_MONITOR_SEQUENCE_LEN     ((uint8_t)(sizeof(Hal_EnergyMonitor_Sequence) / sizeof(Hal_EnergyMonitor_Sequence[0])))
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
+
+/*
+ * Results shared between the HAL task (writer) and the application (readers)
+ */
+typedef SNAPSHOT_TYPE(Hal_EnergyMonitor_Data_t) Hal_EnergyMonitor_Snapshot_t;
+typedef SNAPSHOT_TYPE(Hal_EnergyMonitor_Energy_t) Hal_EnergyMonitor_EnergySnapshot_t;
+
 /*
- * Possible states of module
+ * Integration state of one channel - HAL task, cleared by Hal_EnergyMonitor_ResetEnergy in a critical section
  */
-typedef enum
+typedef struct
 {
-    EnergyMonitor_StateUninit = 0,
-    EnergyMonitor_StateBusVoltage,
-    EnergyMonitor_StatePower,
-    EnergyMonitor_StateCurrent,
-    EnergyMonitor_StateFinished
-}Hal_EnergyMonitor_State_t;
+    int32_t power;          /* uW - previous sample */
+    int32_t current;        /* uA - previous sample */
+    uint64_t timestamp;     /* ns - previous sample */
+    bool valid;             /* Previous sample exists */
+    int64_t energy_rest;    /* pJ not yet added to the energy */
+    int64_t charge_rest;    /* pC not yet added to the charge */
+}Hal_EnergyMonitor_Integrator_t;
+
+/*
+ * Sample history - one writer (HAL task), any number of readers with own cursors. The writer never
+ * waits for the readers, a reader too slow to keep up loses the oldest samples.
+ */
+typedef struct
+{
+    Hal_EnergyMonitor_Sample_t samples[HAL_ENERGY_MONITOR_HISTORY_LEN] __attribute__((aligned(HAL_ENERGY_MONITOR_CACHE_LINE)));
+    volatile uint32_t head;     /* Number of samples written since start-up */
+    uint32_t sequence[HAL_ENERGY_MONITOR_CHANNELS_NUM];    /* Samples of the channel written since start-up */
+}Hal_EnergyMonitor_History_t;
 
 /***********************************************************************************************************
  **************************************** Local function prototypes ****************************************
  ***********************************************************************************************************/
 
 static void Hal_EnergyMonitor_Task(void const * argument);
-static void Hal_EnergyMonitor_ReadResults(void);
+static void Hal_EnergyMonitor_InitDriver(void);
+static void Hal_EnergyMonitor_WaitDriver(void);
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+static void Hal_EnergyMonitor_Reconfigure(void);
+static uint32_t Hal_EnergyMonitor_ConversionTime(uint16_t configuration);
+#endif
+static void Hal_EnergyMonitor_ReadResults(INA226_Channel_t channel);
+static void Hal_EnergyMonitor_Convert(const INA226_Results_t* results, Hal_EnergyMonitor_Data_t* data);
+static void Hal_EnergyMonitor_Integrate(INA226_Channel_t channel, const Hal_EnergyMonitor_Data_t* data);
+static void Hal_EnergyMonitor_StoreSample(INA226_Channel_t channel, const Hal_EnergyMonitor_Data_t* data);
+static void Hal_EnergyMonitor_SequenceCompleteCb(INA226_Channel_t channel, uint8_t status);
+static void Hal_EnergyMonitor_InitCompleteCb(void);
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+static void Hal_EnergyMonitor_CheckFlags(INA226_Channel_t channel);
+#endif
 
 /***********************************************************************************************************
  ******************************************** Exported objects *********************************************
@@ -41,9 +96,77 @@ static void Hal_EnergyMonitor_ReadResults(void);
  ********************************************* Local objects ***********************************************
  ***********************************************************************************************************/
 
-static Hal_EnergyMonitor_Data_t Hal_EnergyMonitor_Data;
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 0U)
+_Static_assert(HAL_ENERGY_MONITOR_SWEEP_TIME < HAL_ENERGY_MONITOR_PERIOD, "Too many channels for the sampling period");
+#endif
+_Static_assert((HAL_ENERGY_MONITOR_HISTORY_LEN & HAL_ENERGY_MONITOR_HISTORY_MASK) == 0U, "History length has to be a power of 2");
+_Static_assert(HAL_ENERGY_MONITOR_HISTORY_HALF >= HAL_ENERGY_MONITOR_CHANNELS_NUM, "Half of the history has to hold one sweep");
+_Static_assert((sizeof(Hal_EnergyMonitor_Sample_t) % HAL_ENERGY_MONITOR_CACHE_LINE) == 0U, "Sample should fill whole cache lines");
+
+osSemaphoreDef(Hal_EnergyMonitor_ConversionReady);
+
+static Hal_EnergyMonitor_Snapshot_t Hal_EnergyMonitor_Data[HAL_ENERGY_MONITOR_CHANNELS_NUM];
+static Hal_EnergyMonitor_EnergySnapshot_t Hal_EnergyMonitor_Energy[HAL_ENERGY_MONITOR_CHANNELS_NUM];
+static Hal_EnergyMonitor_Integrator_t Hal_EnergyMonitor_Integrator[HAL_ENERGY_MONITOR_CHANNELS_NUM];
+static Hal_EnergyMonitor_History_t Hal_EnergyMonitor_History;
 static osThreadId Hal_EnergyMonitor_TaskHandle;
-static Hal_EnergyMonitor_State_t Hal_EnergyMonitor_State = EnergyMonitor_StateUninit;
+static osSemaphoreId Hal_EnergyMonitor_ConversionReady;
+static volatile Hal_EnergyMonitor_HistoryCb_t Hal_EnergyMonitor_HistoryCb;
+static volatile uint8_t Hal_EnergyMonitor_SequenceStatus;      /* Status of the last completed sequence */
+#if (BENCH_ENABLE == 1U)
+static volatile Hal_EnergyMonitor_Data_t Hal_EnergyMonitor_BenchSink;  /* Keeps the benchmarked conversion */
+#endif
+
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+/* Sensor configuration - requested by Hal_EnergyMonitor_SetPeriod, written by the HAL task between sweeps */
+static volatile uint16_t Hal_EnergyMonitor_Configuration = INA226_CFG_CONFIGURATION;
+static uint16_t Hal_EnergyMonitor_ActiveConfiguration = INA226_CFG_CONFIGURATION;
+static uint32_t Hal_EnergyMonitor_CnvrTimeout = HAL_ENERGY_MONITOR_CNVR_TIMEOUT;
+static const uint16_t Hal_EnergyMonitor_ConversionTimeUs[] = INA226_CONVERSION_TIME_US;
+static const uint16_t Hal_EnergyMonitor_Averages[] = INA226_AVERAGES;
+#else
+static volatile uint32_t Hal_EnergyMonitor_Period = HAL_ENERGY_MONITOR_PERIOD;
+#endif
+
+/*
+ * Registers read in one sequence, in this order. Mask/Enable leads every sweep in conversion ready mode,
+ * so the device pointer has to be moved to it each time.
+ */
+static const INAA226_DataType_t Hal_EnergyMonitor_Sequence[] =
+{
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+    INA226_MaskEnable,  /* Tells if the data is fresh and releases the ALERT pin */
+#endif
+#if (HAL_ENERGY_MONITOR_SHUNT_MODE == 1U)
+    INA226_ShuntVoltage,
+    INA226_BusVoltage
+#else
+    INA226_BusVoltage,
+    INA226_Power,
+    INA226_Current
+#endif
+};
+
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 0U)
+/*
+ * Every other sweep reads the registers in reverse - it starts at the register the device pointer was
+ * left at, so the driver skips one pointer write per channel and sweep
+ */
+static const INAA226_DataType_t Hal_EnergyMonitor_SequenceReverse[] =
+{
+#if (HAL_ENERGY_MONITOR_SHUNT_MODE == 1U)
+    INA226_BusVoltage,
+    INA226_ShuntVoltage
+#else
+    INA226_Current,
+    INA226_Power,
+    INA226_BusVoltage
+#endif
+};
+#endif
+
+/* The sequence timeout is derived from this register count, see hal_energy_monitor_cfg.h */
+_Static_assert(HAL_ENERGY_MONITOR_SEQUENCE_LEN == HAL_ENERGY_MONITOR_SEQUENCE_REGISTERS, "Sequence timeout does not match the register count");
 
 /***********************************************************************************************************
  ******************************************* Exported functions ********************************************
@@ -58,33 +181,245 @@ static Hal_EnergyMonitor_State_t Hal_EnergyMonitor_State = EnergyMonitor_StateUn
  */
 void Hal_EnergyMonitor_Init(void)
 {
+    /* Create semaphore - conversion ready events from the ALERT pin */
+    Hal_EnergyMonitor_ConversionReady = osSemaphoreCreate(osSemaphore(Hal_EnergyMonitor_ConversionReady), 1);
+
     /* Create thread */
     osThreadDef(Hal_EnergyMonitor, Hal_EnergyMonitor_Task, osPriorityNormal, 0, 128);
     Hal_EnergyMonitor_TaskHandle = osThreadCreate(osThread(Hal_EnergyMonitor), NULL);
-
-    Hal_EnergyMonitor_State = EnergyMonitor_StateBusVoltage;
 }
 
 /*!	
- * \brief Get results
+ * \brief Get results - all values come from the same measurement, the call never blocks
  *
+ * \param[in] channel Channel to return results of
  * \param[in] data Pointer to store results
  * 
  * \retval None
  */
-void Hal_EnergyMonitor_GetResults(Hal_EnergyMonitor_Data_t* data)
+void Hal_EnergyMonitor_GetResults(uint8_t channel, Hal_EnergyMonitor_Data_t* data)
+{
+    if(channel < HAL_ENERGY_MONITOR_CHANNELS_NUM)
+    {
+        Snapshot_Read(&Hal_EnergyMonitor_Data[channel], data);
+    }
+}
+
+/*!	
+ * \brief Get energy and charge - integrated at the acquisition rate, the call never blocks
+ *
+ * \param[in] channel Channel to return energy of
+ * \param[in] energy Pointer to store energy
+ * 
+ * \retval None
+ */
+void Hal_EnergyMonitor_GetEnergy(uint8_t channel, Hal_EnergyMonitor_Energy_t* energy)
+{
+    if(channel < HAL_ENERGY_MONITOR_CHANNELS_NUM)
+    {
+        Snapshot_Read(&Hal_EnergyMonitor_Energy[channel], energy);
+    }
+}
+
+/*!	
+ * \brief Read samples of all channels stored since the last call - the call never blocks.
+ *        Every reader keeps own cursor (0 at start-up). When the reader is too slow the oldest
+ *        samples are skipped, the gap is visible in the sample sequence numbers.
+ *
+ * \param[out] buf Buffer for the samples, oldest first
+ * \param[in] max Size of the buffer in samples
+ * \param[in,out] cursor Reader position, updated by the call
+ * 
+ * \retval Number of samples stored in buf
+ */
+uint32_t Hal_EnergyMonitor_ReadBatch(Hal_EnergyMonitor_Sample_t* buf, uint32_t max, uint32_t* cursor)
+{
+    uint32_t head = Hal_EnergyMonitor_History.head;
+    uint32_t start = *cursor;
+    uint32_t num;
+    uint32_t lost;
+
+    __DMB();
+
+    /* Oldest samples already overwritten */
+    if((head - start) > HAL_ENERGY_MONITOR_HISTORY_LEN)
+    {
+        start = head - HAL_ENERGY_MONITOR_HISTORY_LEN;
+    }
+
+    num = head - start;
+    if(num > max)
+    {
+        num = max;
+    }
+
+    for(uint32_t i = 0; i < num; i++)
+    {
+        buf[i] = Hal_EnergyMonitor_History.samples[(start + i) & HAL_ENERGY_MONITOR_HISTORY_MASK];
+    }
+
+    __DMB();
+
+    /* Samples overwritten during the copy - the slot of the head sample may be written just now */
+    head = Hal_EnergyMonitor_History.head;
+    if((head - start) >= HAL_ENERGY_MONITOR_HISTORY_LEN)
+    {
+        lost = head - start - HAL_ENERGY_MONITOR_HISTORY_LEN + 1U;
+        if(lost > num)
+        {
+            lost = num;
+        }
+
+        num -= lost;
+        memmove(buf, &buf[lost], num * sizeof(Hal_EnergyMonitor_Sample_t));
+        start += lost;
+    }
+
+    *cursor = start + num;
+
+    return num;
+}
+
+/*!	
+ * \brief Set the acquisition period - the call never blocks, the period is applied by the HAL task
+ *        before the next sweep. In conversion ready mode the period is given by the sensors, the
+ *        largest averaging which converts within the period is selected.
+ *
+ * \param[in] period Requested period in ms
+ * 
+ * \retval Status code - not OK if the period is too short
+ */
+uint8_t Hal_EnergyMonitor_SetPeriod(uint32_t period)
+{
+    uint8_t ret_val = HAL_ENERGY_MONITOR_CODE_NOT_OK;
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+    uint16_t configuration = Hal_EnergyMonitor_Configuration & \
+                             (uint16_t)~(INA226_MAX_CONFIGURATION_AVG << INA226_POS_CONFIGURATION_AVG);
+    uint32_t conversion = Hal_EnergyMonitor_ConversionTime(configuration);
+
+    for(uint16_t avg = 0U; avg <= INA226_MAX_CONFIGURATION_AVG; avg++)
+    {
+        if(((uint64_t)conversion * Hal_EnergyMonitor_Averages[avg]) <= ((uint64_t)period * HAL_ENERGY_MONITOR_US_IN_MS))
+        {
+            Hal_EnergyMonitor_Configuration = configuration | (uint16_t)(avg << INA226_POS_CONFIGURATION_AVG);
+            ret_val = HAL_ENERGY_MONITOR_CODE_OK;
+        }
+    }
+#else
+    if(period > HAL_ENERGY_MONITOR_SWEEP_TIME)
+    {
+        Hal_EnergyMonitor_Period = period;
+        ret_val = HAL_ENERGY_MONITOR_CODE_OK;
+    }
+#endif
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Get the acquisition period - the last requested one, it may not be applied yet
+ *
+ * \param[in] None
+ * 
+ * \retval Period in us
+ */
+uint32_t Hal_EnergyMonitor_GetPeriod(void)
+{
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+    uint16_t configuration = Hal_EnergyMonitor_Configuration;
+    uint16_t avg = (configuration >> INA226_POS_CONFIGURATION_AVG) & INA226_MAX_CONFIGURATION_AVG;
+
+    return Hal_EnergyMonitor_ConversionTime(configuration) * Hal_EnergyMonitor_Averages[avg];
+#else
+    return Hal_EnergyMonitor_Period * HAL_ENERGY_MONITOR_US_IN_MS;
+#endif
+}
+
+/*!	
+ * \brief Reset energy and charge of all channels at once, failed channels included. Integration
+ *        restarts from the next sample of every channel, the interval spanning the reset is not added.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Hal_EnergyMonitor_ResetEnergy(void)
+{
+    Hal_EnergyMonitor_Energy_t* energy;
+
+    /* Excludes Hal_EnergyMonitor_Integrate - the HAL task is the other writer of the energy */
+    taskENTER_CRITICAL();
+
+    for(uint8_t i = 0; i < HAL_ENERGY_MONITOR_CHANNELS_NUM; i++)
+    {
+        energy = Snapshot_WriteBuf(&Hal_EnergyMonitor_Energy[i]);
+        energy->energy = 0;
+        energy->charge = 0;
+        energy->timestamp = Snapshot_ReadBuf(&Hal_EnergyMonitor_Energy[i])->timestamp;
+        Snapshot_Publish(&Hal_EnergyMonitor_Energy[i]);
+
+        Hal_EnergyMonitor_Integrator[i].energy_rest = 0;
+        Hal_EnergyMonitor_Integrator[i].charge_rest = 0;
+        Hal_EnergyMonitor_Integrator[i].valid = false;
+    }
+
+    taskEXIT_CRITICAL();
+}
+
+/*!	
+ * \brief Register the history callback - the reader is signalled at half-full instead of polling the
+ *        history faster than it fills (HAL_ENERGY_MONITOR_HISTORY_LEN samples at any sampling rate)
+ *
+ * \param[in] cb Callback, NULL to disable
+ * 
+ * \retval None
+ */
+void Hal_EnergyMonitor_SetHistoryCb(Hal_EnergyMonitor_HistoryCb_t cb)
+{
+    Hal_EnergyMonitor_HistoryCb = cb;
+}
+
+/*!	
+ * \brief Conversion ready callback (INA226 ALERT pin falling edge) - should be called from ISR
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Hal_EnergyMonitor_ConversionReadyCb(void)
+{
+    (void)osSemaphoreRelease(Hal_EnergyMonitor_ConversionReady);
+}
+
+#if (BENCH_ENABLE == 1U)
+/*!	
+ * \brief Benchmark of the integer conversion - the last register set of channel 0, nothing is published
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Hal_EnergyMonitor_BenchConvert(void)
 {
-    data->bus_voltage = Hal_EnergyMonitor_Data.bus_voltage;
-    data->current = Hal_EnergyMonitor_Data.current;
-    data->power = Hal_EnergyMonitor_Data.power;
+    Hal_EnergyMonitor_Data_t data;
+    INA226_Results_t results;
+
+    (void)INA226_GetResults((INA226_Channel_t)0, &results);
+    Hal_EnergyMonitor_Convert(&results, &data);
+    Hal_EnergyMonitor_BenchSink = data;
 }
+#endif
 
 /***********************************************************************************************************
  ******************************************** Local functions **********************************************
  ***********************************************************************************************************/
 
 /*!	
- * \brief HAL energy monitor task
+ * \brief HAL energy monitor task - channels are sampled round-robin, one after another.
+ *        The whole sweep is repeated every HAL_ENERGY_MONITOR_PERIOD or, in conversion
+ *        ready mode, once per conversion signalled on the ALERT pin. All registers of one
+ *        channel are read by the driver in one sequence, the task is woken up once when
+ *        the whole set is coherent.
  *
  * \param[in] argument OS required parameter
  * 
@@ -92,59 +427,334 @@ void Hal_EnergyMonitor_GetResults(Hal_EnergyMonitor_Data_t* data)
  */
 static void Hal_EnergyMonitor_Task(void const * argument)
 {
-    uint32_t time = osKernelSysTick();
+    const INAA226_DataType_t* sequence = Hal_EnergyMonitor_Sequence;
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 0U)
+    uint32_t time;
+#endif
+    osEvent event;
+
+    /* Sensors are configured here, so the boot does not wait for them */
+    Hal_EnergyMonitor_InitDriver();
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 0U)
+    time = osKernelSysTick();
+#endif
 
     while(1)
     {
-        switch (Hal_EnergyMonitor_State)
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+        if(Hal_EnergyMonitor_Configuration != Hal_EnergyMonitor_ActiveConfiguration)
         {
-            case EnergyMonitor_StateBusVoltage:
-                INA226_ReadMeasurement(INA226_BusVoltage);
-                Hal_EnergyMonitor_State++;
-                osDelayUntil(&time, 1U);
-                break;
-            case EnergyMonitor_StatePower:
-                INA226_ReadMeasurement(INA226_Power);
-                Hal_EnergyMonitor_State++;
-                osDelayUntil(&time, 1U);
-                break;
-            case EnergyMonitor_StateCurrent:
-                INA226_ReadMeasurement(INA226_Current);
-                Hal_EnergyMonitor_State++;
-                osDelayUntil(&time, 1U);
-                break;
-            case EnergyMonitor_StateFinished:
-                Hal_EnergyMonitor_ReadResults();
-                Hal_EnergyMonitor_State = EnergyMonitor_StateBusVoltage;
-                osDelayUntil(&time, 47U);  /* 50ms = 47+1+1+1, measurements are read every 50ms */
-                break;
-            default:
-                /* Do nothing */
-                break;
+            Hal_EnergyMonitor_Reconfigure();
+        }
+
+        /* The ALERT pin stays asserted until Mask/Enable is read, so a sweep after timeout recovers a missed edge */
+        (void)osSemaphoreWait(Hal_EnergyMonitor_ConversionReady, Hal_EnergyMonitor_CnvrTimeout);
+#endif
+
+        for(uint8_t i = 0; i < HAL_ENERGY_MONITOR_CHANNELS_NUM; i++)
+        {
+            /* Drop a late signal of a previous, timed out sequence */
+            (void)osSignalWait(HAL_ENERGY_MONITOR_SIGNAL_DONE, 0U);
+
+            if(INA226_ReadSequence((INA226_Channel_t)i, sequence, HAL_ENERGY_MONITOR_SEQUENCE_LEN, \
+                                   Hal_EnergyMonitor_SequenceCompleteCb) == INA226_CODE_OK)
+            {
+                event = osSignalWait(HAL_ENERGY_MONITOR_SIGNAL_DONE, HAL_ENERGY_MONITOR_SEQUENCE_TIMEOUT);
+
+                if(event.status != osEventSignal)
+                {
+                    INA226_Abort();  /* Release the bus for the next channel */
+                    (void)Log_Write(Log_SequenceTimeout, (int32_t)i, 0, 0);
+
+                    /* The driver signals the release when the peripheral has stopped the transfer */
+                    if(osSignalWait(HAL_ENERGY_MONITOR_SIGNAL_DONE, HAL_ENERGY_MONITOR_SEQUENCE_TIMEOUT).status != osEventSignal)
+                    {
+                        INA226_Abort();  /* Abort not confirmed - released at once */
+                    }
+                }
+                else if(Hal_EnergyMonitor_SequenceStatus == INA226_CODE_OK)
+                {
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+                    Hal_EnergyMonitor_CheckFlags((INA226_Channel_t)i);
+#else
+                    Hal_EnergyMonitor_ReadResults((INA226_Channel_t)i);
+#endif
+                }
+                else
+                {
+                    /* Failed on an I2C error - logged and the bus released by the driver */
+                }
+            }
         }
+
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 0U)
+        sequence = (sequence == Hal_EnergyMonitor_Sequence) ? Hal_EnergyMonitor_SequenceReverse : Hal_EnergyMonitor_Sequence;
+        osDelayUntil(&time, Hal_EnergyMonitor_Period);
+#endif
     }
 }
 
 /*!	
- * \brief Function reads results from the lower layer
+ * \brief Function configures the sensors - the driver writes the registers from the I2C callbacks,
+ *        the task only supervises the timeout of each write. Absent sensors are marked failed by
+ *        the driver after the retries and are skipped by the sweeps.
  *
  * \param[in] None
  * 
  * \retval None
  */
-static void Hal_EnergyMonitor_ReadResults(void)
+static void Hal_EnergyMonitor_InitDriver(void)
+{
+    INA226_Init(Hal_EnergyMonitor_InitCompleteCb);
+    Hal_EnergyMonitor_WaitDriver();
+}
+
+/*!	
+ * \brief Function supervises the register writes of the driver until all sensors are configured -
+ *        the driver signals every write, so HAL_ENERGY_MONITOR_INIT_TIMEOUT covers one write
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_WaitDriver(void)
+{
+    osEvent event;
+
+    while(!INA226_IsInitialized())
+    {
+        event = osSignalWait(HAL_ENERGY_MONITOR_SIGNAL_DONE, HAL_ENERGY_MONITOR_INIT_TIMEOUT);
+
+        if(event.status != osEventSignal)
+        {
+            INA226_Abort();  /* Write lost or not started - retried by the driver after the release */
+        }
+    }
+}
+
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+/*!	
+ * \brief Function writes the requested configuration to the sensors - called between sweeps,
+ *        so the bus is free. The missed edge timeout follows the new conversion period.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_Reconfigure(void)
+{
+    uint16_t configuration = Hal_EnergyMonitor_Configuration;
+
+    if(INA226_Reconfigure(configuration, Hal_EnergyMonitor_InitCompleteCb) == INA226_CODE_OK)
+    {
+        Hal_EnergyMonitor_WaitDriver();
+        Hal_EnergyMonitor_ActiveConfiguration = configuration;
+        Hal_EnergyMonitor_CnvrTimeout = ((2U * Hal_EnergyMonitor_GetPeriod()) / HAL_ENERGY_MONITOR_US_IN_MS) + 1U;
+    }
+}
+
+/*!	
+ * \brief Function returns the time of one conversion of the enabled inputs, without averaging
+ *
+ * \param[in] configuration Configuration register value
+ * 
+ * \retval Conversion time in us
+ */
+static uint32_t Hal_EnergyMonitor_ConversionTime(uint16_t configuration)
+{
+    uint16_t mode = (configuration >> INA226_POS_CONFIGURATION_MODE) & INA226_MAX_CONFIGURATION_MODE;
+    uint16_t vshct = (configuration >> INA226_POS_CONFIGURATION_VSHCT) & INA226_MAX_CONFIGURATION_VSHCT;
+    uint16_t vbusct = (configuration >> INA226_POS_CONFIGURATION_VBUSCT) & INA226_MAX_CONFIGURATION_VBUSCT;
+    uint32_t time = 0U;
+
+    if(mode & INA226_MODE_SHUNT)
+    {
+        time += Hal_EnergyMonitor_ConversionTimeUs[vshct];
+    }
+
+    if(mode & INA226_MODE_BUS)
+    {
+        time += Hal_EnergyMonitor_ConversionTimeUs[vbusct];
+    }
+
+    return time;
+}
+
+/*!	
+ * \brief Function demultiplexes the shared ALERT pin - results are taken only from a fresh
+ *        conversion and the alert function is reported to the GPIO layer
+ *
+ * \param[in] channel Channel to check
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_CheckFlags(INA226_Channel_t channel)
+{
+    uint16_t flags = INA226_GetResult(channel, INA226_MaskEnable);
+
+    if(flags & INA226_FLAG_CONVERSION_READY)
+    {
+        Hal_EnergyMonitor_ReadResults(channel);
+    }
+
+    if(flags & INA226_FLAG_ALERT_FUNCTION)
+    {
+        Hal_Gpio_AlertCb();
+    }
+}
+#endif
+
+/*!	
+ * \brief Function reads results from the lower layer and converts them into uV, uA and uW.
+ *        Integer only - no rounding drift, floats are left to the presentation.
+ *
+ * \param[in] channel Channel to read
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_ReadResults(INA226_Channel_t channel)
 {
-    uint16_t result = 0U;
+    Hal_EnergyMonitor_Data_t* data = Snapshot_WriteBuf(&Hal_EnergyMonitor_Data[channel]);
+    INA226_Results_t results;
+
+    BENCH_PROBE_BEGIN(Bench_ReadResults);
 
-    /* Read bus voltage */
-    result = INA226_GetResult(INA226_BusVoltage);
-    Hal_EnergyMonitor_Data.bus_voltage = result * HAL_ENERGY_MONITOR_BUS_VOLTAGE_LSB / 1000.0f;  /* Conwert to V */
+    (void)INA226_GetResults(channel, &results);
+    Hal_EnergyMonitor_Convert(&results, data);
 
-    /* Read power */
-    result = INA226_GetResult(INA226_Power);
-    Hal_EnergyMonitor_Data.power = result * HAL_ENERGY_MONITOR_POWER_LSB * 1000.0f;  /* Conwert to mW */
+    Hal_EnergyMonitor_Integrate(channel, data);
+    Hal_EnergyMonitor_StoreSample(channel, data);
+
+    Snapshot_Publish(&Hal_EnergyMonitor_Data[channel]);
+
+    BENCH_PROBE_END(Bench_ReadResults);
+}
+
+/*!	
+ * \brief Function converts one register set into uV, uA and uW
+ *
+ * \param[in] results Register values of the driver
+ * \param[out] data Converted values
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_Convert(const INA226_Results_t* results, Hal_EnergyMonitor_Data_t* data)
+{
+    data->bus_voltage = (int32_t)results->bus_voltage * HAL_ENERGY_MONITOR_BUS_VOLTAGE_LSB_UV;
+#if (HAL_ENERGY_MONITOR_SHUNT_MODE == 1U)
+    /* I = Vshunt / Rshunt, nV / mOhm = uA, Vshunt is two's complement */
+    data->current = ((int32_t)(int16_t)results->shunt_voltage * HAL_ENERGY_MONITOR_SHUNT_VOLTAGE_LSB_NV) / \
+                    HAL_ENERGY_MONITOR_SHUNT_RESISTANCE_MOHM;
+    data->power = (int32_t)(((int64_t)data->bus_voltage * data->current) / 1000000);
+#else
+    /* Current is two's complement, power is always positive */
+    data->current = (int32_t)(((int16_t)results->current * HAL_ENERGY_MONITOR_CURRENT_LSB_NA) / 1000);
+    data->power = (int32_t)((results->power * HAL_ENERGY_MONITOR_POWER_LSB_NW) / 1000);
+#endif
+    data->timestamp = Dwt_CyclesToNs(results->timestamp);
+    data->sequence = results->sequence;
+}
+
+/*!	
+ * \brief Function stores the sample in the history - the slot is filled first, then published.
+ *        The reader is signalled every half of the history.
+ *
+ * \param[in] channel Channel of the sample
+ * \param[in] data New sample
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_StoreSample(INA226_Channel_t channel, const Hal_EnergyMonitor_Data_t* data)
+{
+    Hal_EnergyMonitor_Sample_t* sample;
+    Hal_EnergyMonitor_HistoryCb_t cb = Hal_EnergyMonitor_HistoryCb;
+    uint32_t head = Hal_EnergyMonitor_History.head;
+
+    sample = &Hal_EnergyMonitor_History.samples[head & HAL_ENERGY_MONITOR_HISTORY_MASK];
+    sample->timestamp = data->timestamp;
+    sample->bus_voltage = data->bus_voltage;
+    sample->current = data->current;
+    sample->power = data->power;
+    sample->sequence = ++Hal_EnergyMonitor_History.sequence[channel];
+    sample->channel = (uint8_t)channel;
+
+    __DMB();
+    Hal_EnergyMonitor_History.head = head + 1U;
+
+    if((((head + 1U) % HAL_ENERGY_MONITOR_HISTORY_HALF) == 0U) && (cb != NULL))
+    {
+        cb();
+    }
+}
 
-    /* Read current */
-    result = INA226_GetResult(INA226_Current);
-    Hal_EnergyMonitor_Data.current = result * HAL_ENERGY_MONITOR_CURRENT_LSB * 1000.0f;  /* Conwert to mA */
+/*!	
+ * \brief Function integrates power and current over the real interval between two samples
+ *        (trapezoidal rule). Parts below 1 nWh / 1 nAh are carried to the next sample.
+ *
+ * \param[in] channel Channel of the sample
+ * \param[in] data New sample
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_Integrate(INA226_Channel_t channel, const Hal_EnergyMonitor_Data_t* data)
+{
+    Hal_EnergyMonitor_Integrator_t* integrator = &Hal_EnergyMonitor_Integrator[channel];
+    Hal_EnergyMonitor_Energy_t* energy;
+    int64_t interval;   /* us */
+
+    taskENTER_CRITICAL();
+
+    energy = Snapshot_WriteBuf(&Hal_EnergyMonitor_Energy[channel]);
+    *energy = *Snapshot_ReadBuf(&Hal_EnergyMonitor_Energy[channel]);
+    interval = (int64_t)((data->timestamp - integrator->timestamp) / HAL_ENERGY_MONITOR_NS_IN_US);
+
+    /* Samples lost - the interval is not integrated, only the last known power would be guessed */
+    if(integrator->valid && (interval <= ((int64_t)HAL_ENERGY_MONITOR_INTEGRATION_GAP * 1000)))
+    {
+        integrator->energy_rest += (((int64_t)integrator->power + data->power) * interval) / 2;
+        integrator->charge_rest += (((int64_t)integrator->current + data->current) * interval) / 2;
+
+        energy->energy += integrator->energy_rest / HAL_ENERGY_MONITOR_PJ_IN_NWH;
+        energy->charge += integrator->charge_rest / HAL_ENERGY_MONITOR_PC_IN_NAH;
+        integrator->energy_rest %= HAL_ENERGY_MONITOR_PJ_IN_NWH;
+        integrator->charge_rest %= HAL_ENERGY_MONITOR_PC_IN_NAH;
+    }
+
+    integrator->power = data->power;
+    integrator->current = data->current;
+    integrator->timestamp = data->timestamp;
+    integrator->valid = true;
+
+    energy->timestamp = data->timestamp;
+    Snapshot_Publish(&Hal_EnergyMonitor_Energy[channel]);
+
+    taskEXIT_CRITICAL();
+}
+
+/*!	
+ * \brief Register sequence complete callback - called from ISR, also when the sequence failed on an I2C
+ *        error or an aborted sequence releases the bus
+ *
+ * \param[in] channel Channel which was read
+ * \param[in] status INA226_CODE_OK if the results are published
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_SequenceCompleteCb(INA226_Channel_t channel, uint8_t status)
+{
+    Hal_EnergyMonitor_SequenceStatus = status;
+    (void)osSignalSet(Hal_EnergyMonitor_TaskHandle, HAL_ENERGY_MONITOR_SIGNAL_DONE);
+}
+
+/*!	
+ * \brief Driver initialization progress callback - called from ISR or from the task after every register write
+ *        and when all sensors are configured or failed
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void Hal_EnergyMonitor_InitCompleteCb(void)
+{
+    (void)osSignalSet(Hal_EnergyMonitor_TaskHandle, HAL_ENERGY_MONITOR_SIGNAL_DONE);
 }
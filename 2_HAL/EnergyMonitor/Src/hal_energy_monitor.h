@@ -6,22 +6,57 @@
  ***********************************************************************************************************/
 
 #include <stdint.h>
+#include "ina226.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
+#define HAL_ENERGY_MONITOR_CHANNELS_NUM     ((uint8_t)INA226_ChannelMax)
+
+/*
+ * Status codes
+ */
+#define HAL_ENERGY_MONITOR_CODE_OK          (0U)
+#define HAL_ENERGY_MONITOR_CODE_NOT_OK      (1U)
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
 
 typedef struct 
 {
-    float bus_voltage;  /* V */
-    float current;      /* mA */
-    float power;        /* mW */
+    int32_t bus_voltage;    /* uV */
+    int32_t current;        /* uA */
+    int32_t power;          /* uW */
+    uint64_t timestamp;     /* ns, acquisition time (DWT cycle counter) */
+    uint32_t sequence;      /* Number of the measurement, tells apart fresh data */
 }Hal_EnergyMonitor_Data_t;
 
+typedef struct 
+{
+    int64_t energy;         /* nWh - accumulated since start-up */
+    int64_t charge;         /* nAh - accumulated since start-up */
+    uint64_t timestamp;     /* ns, last sample included */
+}Hal_EnergyMonitor_Energy_t;
+
+/* One sample of the history - 32 bytes, one cache line */
+typedef struct 
+{
+    uint64_t timestamp;     /* ns, acquisition time (DWT cycle counter) */
+    int32_t bus_voltage;    /* uV */
+    int32_t current;        /* uA */
+    int32_t power;          /* uW */
+    uint32_t sequence;      /* Number of the sample of the channel (1 = first), gaps are samples skipped by the reader */
+    uint8_t channel;
+}Hal_EnergyMonitor_Sample_t;
+
+/*
+ * History callback - called from the HAL task every HAL_ENERGY_MONITOR_HISTORY_LEN / 2 samples, the reader
+ * has the other half of the history to drain it before samples are overwritten
+ */
+typedef void (*Hal_EnergyMonitor_HistoryCb_t)(void);
+
 /***********************************************************************************************************
  ********************************************* Exported objects ********************************************
  ***********************************************************************************************************/
@@ -30,7 +65,26 @@ typedef struct
  ************************************** Exported function prototypes ***************************************
  ***********************************************************************************************************/
 
+/*
+ * API
+ */
 void Hal_EnergyMonitor_Init(void);
-void Hal_EnergyMonitor_GetResults(Hal_EnergyMonitor_Data_t* data);
+void Hal_EnergyMonitor_GetResults(uint8_t channel, Hal_EnergyMonitor_Data_t* data);
+void Hal_EnergyMonitor_GetEnergy(uint8_t channel, Hal_EnergyMonitor_Energy_t* energy);
+uint32_t Hal_EnergyMonitor_ReadBatch(Hal_EnergyMonitor_Sample_t* buf, uint32_t max, uint32_t* cursor);
+uint8_t Hal_EnergyMonitor_SetPeriod(uint32_t period);
+uint32_t Hal_EnergyMonitor_GetPeriod(void);
+void Hal_EnergyMonitor_ResetEnergy(void);
+void Hal_EnergyMonitor_SetHistoryCb(Hal_EnergyMonitor_HistoryCb_t cb);
+
+/*
+ * Callbacks
+ */
+void Hal_EnergyMonitor_ConversionReadyCb(void);
+
+/*
+ * Benchmarks - BENCH_ENABLE build only
+ */
+void Hal_EnergyMonitor_BenchConvert(void);
 
 #endif  /* _HAL_ENERGY_MONITOR_H_ */
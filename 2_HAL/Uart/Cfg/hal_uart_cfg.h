@@ -17,9 +17,37 @@
  * \param[in] buf_ptr Buffer pointer for transmission data
  * \param[in] size Size of data to transmit
  * 
+ * \retval HAL_UART_TRANSMIT_OK if started
+ */
+#define Hal_Uart_Transmit(buf_ptr, size)    (HAL_UART_Transmit_DMA(&huart3, buf_ptr, size))
+#define HAL_UART_TRANSMIT_OK              (HAL_OK)
+
+/*!	
+ * \brief Uart transmitter stopped - no transfer runs, e.g. after a DMA error aborted it
+ *
+ * \param[in] None
+ * 
+ * \retval True if stopped
+ */
+#define Hal_Uart_IsTxStopped()              (huart3.gState == HAL_UART_STATE_READY)
+
+/*!	
+ * \brief Uart receive function - circular DMA reception, the callback is called on idle line,
+ *        half and full buffer with the DMA write position
+ *
+ * \param[in] buf_ptr Buffer pointer for reception data
+ * \param[in] size Size of the buffer
+ * 
  * \retval None
  */
-#define Hal_Uart_Transmit(buf_ptr, size)    (HAL_UART_Transmit_IT(&huart3, buf_ptr, size))
+#define Hal_Uart_Receive(buf_ptr, size)     (HAL_UARTEx_ReceiveToIdle_DMA(&huart3, buf_ptr, size))
+#define HAL_UART_RECEIVE_OK               (HAL_OK)
+
+/*
+ * Ring buffer lengths in bytes - must be a power of 2
+ */
+#define HAL_UART_TX_BUFFER_LEN            (4096U)
+#define HAL_UART_RX_BUFFER_LEN            (256U)
 
 /*
  * Status codes
@@ -2,6 +2,8 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include <string.h>
+#include "cmsis_os.h"
 #include "hal_uart.h"
 #include "hal_uart_cfg.h"
 
@@ -9,6 +11,14 @@
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
+#define HAL_UART_TX_BUFFER_MASK           (HAL_UART_TX_BUFFER_LEN - 1U)
+#define HAL_UART_RX_BUFFER_MASK           (HAL_UART_RX_BUFFER_LEN - 1U)
+
+_Static_assert((HAL_UART_TX_BUFFER_LEN & HAL_UART_TX_BUFFER_MASK) == 0U,
+               "HAL_UART_TX_BUFFER_LEN must be a power of 2");
+_Static_assert((HAL_UART_RX_BUFFER_LEN & HAL_UART_RX_BUFFER_MASK) == 0U,
+               "HAL_UART_RX_BUFFER_LEN must be a power of 2");
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
@@ -24,6 +34,9 @@ typedef enum
  **************************************** Local function prototypes ****************************************
  ***********************************************************************************************************/
 
+static void Hal_Uart_StartTx(void);
+static void Hal_Uart_StartRx(void);
+
 /***********************************************************************************************************
  ******************************************** Exported objects *********************************************
  ***********************************************************************************************************/
@@ -34,6 +47,24 @@ typedef enum
 
 Hal_Uart_Status_t Hal_Uart_Status;
 
+/*
+ * Transmit ring buffer - head and tail are free running, the DMA reads from the tail
+ */
+static uint8_t Hal_Uart_TxBuffer[HAL_UART_TX_BUFFER_LEN];
+static uint32_t Hal_Uart_TxHead;
+static uint32_t Hal_Uart_TxTail;
+static uint32_t Hal_Uart_TxDmaLen;
+
+/*
+ * Receive ring buffer - written by the circular DMA, the head is advanced by the reception events
+ */
+static uint8_t Hal_Uart_RxBuffer[HAL_UART_RX_BUFFER_LEN];
+static volatile uint32_t Hal_Uart_RxHead;
+static uint32_t Hal_Uart_RxTail;
+static uint32_t Hal_Uart_RxPos;     /* DMA position of the last reception event */
+
+static Hal_Uart_Stats_t Hal_Uart_Stats;
+
 /***********************************************************************************************************
  ******************************************* Exported functions ********************************************
  ***********************************************************************************************************/
@@ -47,34 +78,127 @@ Hal_Uart_Status_t Hal_Uart_Status;
  */
 void Hal_Uart_Init(void)
 {
+    Hal_Uart_TxHead = 0U;
+    Hal_Uart_TxTail = 0U;
+    Hal_Uart_TxDmaLen = 0U;
+    Hal_Uart_RxHead = 0U;
+    Hal_Uart_RxTail = 0U;
+    memset(&Hal_Uart_Stats, 0, sizeof(Hal_Uart_Stats));
+
     Hal_Uart_Status = Hal_Uart_Ready;
+
+    Hal_Uart_StartRx();
 }
 
 /*!	
- * \brief Uart transmission function
+ * \brief Uart transmission function - queues data for DMA transmission without blocking,
+ *        the whole message is dropped if it does not fit in the transmit buffer.
+ *        Should be called from task context only.
  *
  * \param[in] data Buffer pointer for transmission data
  * \param[in] size Size of data to transmit
  * 
  * \retval Status code
  */
-uint8_t Hal_Uart_Write(uint8_t* data, uint16_t size)
+uint8_t Hal_Uart_Write(const uint8_t* data, uint16_t size)
 {
     uint8_t ret_val = HAL_UART_CODE_OK;
+    uint32_t head;
+    uint32_t fill;
+    uint32_t first;
 
-    if(Hal_Uart_Status == Hal_Uart_Ready)
+    taskENTER_CRITICAL();
+
+    fill = Hal_Uart_TxHead - Hal_Uart_TxTail;
+
+    if((Hal_Uart_Status == Hal_Uart_Uninitialized) || (size > (HAL_UART_TX_BUFFER_LEN - fill)))
     {
-        Hal_Uart_Status = Hal_Uart_Busy;
-        Hal_Uart_Transmit(data, size);
+        Hal_Uart_Stats.dropped += size;
+        ret_val = HAL_UART_CODE_NOT_OK;
     }
     else
     {
-        ret_val = HAL_UART_CODE_NOT_OK;
+        head = Hal_Uart_TxHead & HAL_UART_TX_BUFFER_MASK;
+        first = HAL_UART_TX_BUFFER_LEN - head;
+
+        if(first > size)
+        {
+            first = size;
+        }
+
+        memcpy(&Hal_Uart_TxBuffer[head], data, first);
+        memcpy(&Hal_Uart_TxBuffer[0], &data[first], size - first);
+
+        Hal_Uart_TxHead += size;
+        Hal_Uart_Stats.queued += size;
+
+        if((fill + size) > Hal_Uart_Stats.high_water)
+        {
+            Hal_Uart_Stats.high_water = fill + size;
+        }
+
+        if(Hal_Uart_Status == Hal_Uart_Ready)
+        {
+            Hal_Uart_StartTx();
+        }
     }
 
+    taskEXIT_CRITICAL();
+
     return ret_val;
 }
 
+/*!	
+ * \brief Uart reception function - copies received data without blocking. A single reader is
+ *        expected. Data overwritten by the DMA before it was read is discarded and counted.
+ *
+ * \param[out] data Buffer for reception data
+ * \param[in] size Size of the buffer
+ * 
+ * \retval Number of bytes copied
+ */
+uint32_t Hal_Uart_Read(uint8_t* data, uint32_t size)
+{
+    uint32_t head = Hal_Uart_RxHead;
+    uint32_t num;
+
+    if((head - Hal_Uart_RxTail) > HAL_UART_RX_BUFFER_LEN)
+    {
+        Hal_Uart_Stats.overrun += head - Hal_Uart_RxTail;
+        Hal_Uart_RxTail = head;
+    }
+
+    num = head - Hal_Uart_RxTail;
+
+    if(num > size)
+    {
+        num = size;
+    }
+
+    for(uint32_t i = 0; i < num; i++)
+    {
+        data[i] = Hal_Uart_RxBuffer[(Hal_Uart_RxTail + i) & HAL_UART_RX_BUFFER_MASK];
+    }
+
+    Hal_Uart_RxTail += num;
+
+    return num;
+}
+
+/*!	
+ * \brief Get transfer statistics
+ *
+ * \param[out] stats Pointer to statistics structure
+ * 
+ * \retval None
+ */
+void Hal_Uart_GetStats(Hal_Uart_Stats_t* stats)
+{
+    taskENTER_CRITICAL();
+    *stats = Hal_Uart_Stats;
+    taskEXIT_CRITICAL();
+}
+
 /*!	
  * \brief Uart write complete callback - should be called from ISR
  *
@@ -86,10 +210,99 @@ void Hal_Uart_WriteCb(void)
 {
     if(Hal_Uart_Status == Hal_Uart_Busy)
     {
+        Hal_Uart_TxTail += Hal_Uart_TxDmaLen;
+        Hal_Uart_Stats.sent += Hal_Uart_TxDmaLen;
+        Hal_Uart_TxDmaLen = 0U;
+
         Hal_Uart_Status = Hal_Uart_Ready;
+        Hal_Uart_StartTx();
     }
 }
 
+/*!	
+ * \brief Uart reception event callback (idle line, half or full buffer) - should be called from ISR
+ *
+ * \param[in] position DMA write position in the receive buffer
+ * 
+ * \retval None
+ */
+void Hal_Uart_ReadCb(uint16_t position)
+{
+    uint32_t pos = position & HAL_UART_RX_BUFFER_MASK;     /* End of the buffer is the start of the next lap */
+    uint32_t num = (pos - Hal_Uart_RxPos) & HAL_UART_RX_BUFFER_MASK;
+
+    Hal_Uart_RxPos = pos;
+    Hal_Uart_Stats.received += num;
+    Hal_Uart_RxHead += num;
+}
+
+/*!	
+ * \brief Uart error callback - should be called from ISR. Blocking errors (e.g. overrun) stop
+ *        the reception, it is restarted from the start of the buffer. A transfer stopped by
+ *        the error (DMA error) never completes, the chunk at the tail is sent again.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Hal_Uart_ErrorCb(void)
+{
+    if((Hal_Uart_Status == Hal_Uart_Busy) && Hal_Uart_IsTxStopped())
+    {
+        Hal_Uart_TxDmaLen = 0U;
+        Hal_Uart_Status = Hal_Uart_Ready;
+        Hal_Uart_StartTx();
+    }
+
+    Hal_Uart_StartRx();
+}
+
 /***********************************************************************************************************
  ******************************************** Local functions **********************************************
  ***********************************************************************************************************/
+
+/*!	
+ * \brief Start DMA transmission of the contiguous chunk at the buffer tail, if any. If the start
+ *        fails, the data stays queued and the start is retried by the next write.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void Hal_Uart_StartTx(void)
+{
+    uint32_t tail = Hal_Uart_TxTail & HAL_UART_TX_BUFFER_MASK;
+    uint32_t len = Hal_Uart_TxHead - Hal_Uart_TxTail;
+
+    if(len > (HAL_UART_TX_BUFFER_LEN - tail))
+    {
+        len = HAL_UART_TX_BUFFER_LEN - tail;
+    }
+
+    if(len > 0U)
+    {
+        Hal_Uart_TxDmaLen = len;
+        Hal_Uart_Status = Hal_Uart_Busy;
+
+        if(Hal_Uart_Transmit(&Hal_Uart_TxBuffer[tail], (uint16_t)len) != HAL_UART_TRANSMIT_OK)
+        {
+            Hal_Uart_TxDmaLen = 0U;
+            Hal_Uart_Status = Hal_Uart_Ready;
+        }
+    }
+}
+
+/*!	
+ * \brief Start circular DMA reception into the receive buffer, nothing is done while the reception runs
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void Hal_Uart_StartRx(void)
+{
+    if(Hal_Uart_Receive(Hal_Uart_RxBuffer, HAL_UART_RX_BUFFER_LEN) == HAL_UART_RECEIVE_OK)
+    {
+        Hal_Uart_RxPos = 0U;
+    }
+}
@@ -15,6 +15,19 @@
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
 
+/*
+ * Transfer statistics, all counters in bytes
+ */
+typedef struct
+{
+    uint32_t queued;        /* Bytes accepted into the transmit buffer */
+    uint32_t sent;          /* Bytes handed over to the UART by the DMA */
+    uint32_t dropped;       /* Bytes rejected because the transmit buffer was full */
+    uint32_t high_water;    /* Highest transmit buffer fill level seen */
+    uint32_t received;      /* Bytes written into the receive buffer by the DMA */
+    uint32_t overrun;       /* Received bytes overwritten before they were read */
+}Hal_Uart_Stats_t;
+
 /***********************************************************************************************************
  ********************************************* Exported objects ********************************************
  ***********************************************************************************************************/
@@ -27,11 +40,15 @@
  * API
  */
 void Hal_Uart_Init(void);
-uint8_t Hal_Uart_Write(uint8_t* data, uint16_t size);
+uint8_t Hal_Uart_Write(const uint8_t* data, uint16_t size);
+uint32_t Hal_Uart_Read(uint8_t* data, uint32_t size);
+void Hal_Uart_GetStats(Hal_Uart_Stats_t* stats);
 
 /*
  * Callbacks
  */
 void Hal_Uart_WriteCb(void);
+void Hal_Uart_ReadCb(uint16_t position);
+void Hal_Uart_ErrorCb(void);
 
 #endif  /* _HAL_UART_H_ */
@@ -0,0 +1,60 @@
+#ifndef _BENCH_CFG_H_
+#define _BENCH_CFG_H_
+
+/* 
+ * Benchmark configuration file - all below defines should be filled by the user
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#ifndef BENCH_ENABLE
+#define BENCH_ENABLE                    (0U)    /* Defined to 1 by the benchmark build target */
+#endif
+
+#define BENCH_WARMUP                    (4U)    /* Runs/passes not measured - caches, branch predictor */
+#define BENCH_REPETITIONS               (32U)   /* Measured runs/passes of every benchmark */
+
+/*
+ * Benchmarks: id, name, function. BENCH_CFG_BENCHMARK entries are run by the harness - the function is
+ * called between two cycle counter reads, so "empty" shows the measurement overhead. BENCH_CFG_PROBE
+ * entries measure the live code between BENCH_PROBE_BEGIN and BENCH_PROBE_END wherever it runs, task
+ * or ISR. One probe id must be used from one context only.
+ */
+#define BENCH_CFG_TABLE  \
+    BENCH_CFG_BENCHMARK(Bench_Empty,          "empty",                App_Bench_Empty)                   \
+    BENCH_CFG_BENCHMARK(Bench_ContextSwitch,  "context_switch_x2",    App_Bench_ContextSwitch)           \
+    BENCH_CFG_BENCHMARK(Bench_FormatLine,     "app_format_line",      App_EnergyMonitor_BenchFormatLine) \
+    BENCH_CFG_BENCHMARK(Bench_SnprintfLine,   "snprintf_line",        App_Bench_SnprintfLine)            \
+    BENCH_CFG_BENCHMARK(Bench_EncodeSample,   "telemetry_record",     App_Telemetry_BenchEncodeSample)   \
+    BENCH_CFG_BENCHMARK(Bench_StreamAdd,      "telemetry_stream_add", App_Telemetry_BenchStreamAdd)      \
+    BENCH_CFG_BENCHMARK(Bench_StreamEnd,      "telemetry_stream_end", App_Telemetry_BenchStreamEnd)      \
+    BENCH_CFG_BENCHMARK(Bench_Convert,        "hal_convert",          Hal_EnergyMonitor_BenchConvert)    \
+    BENCH_CFG_BENCHMARK(Bench_ConvertFloat,   "float_convert",        App_Bench_ConvertFloat)            \
+    BENCH_CFG_BENCHMARK(Bench_TaskStats,      "app_task_stats",       App_TaskStats_BenchUpdate)         \
+    BENCH_CFG_PROBE(Bench_ReadResults,    "hal_read_results")                                            \
+    BENCH_CFG_PROBE(Bench_TransmitLog,    "app_transmit_log")                                            \
+    BENCH_CFG_PROBE(Bench_I2cTxCplt,      "irq_i2c_tx_cplt")                                             \
+    BENCH_CFG_PROBE(Bench_I2cRxCplt,      "irq_i2c_rx_cplt")                                             \
+    BENCH_CFG_PROBE(Bench_GpioExti,       "irq_gpio_exti")                                               \
+    BENCH_CFG_PROBE(Bench_UartTxCplt,     "irq_uart_tx_cplt")                                            \
+    BENCH_CFG_PROBE(Bench_UartRxEvent,    "irq_uart_rx_event")
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _BENCH_CFG_H_ */
@@ -0,0 +1,194 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "bench.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef void (*Bench_Function_t)(void);
+
+typedef struct
+{
+    uint32_t cycles[BENCH_REPETITIONS];
+    atomic_uint count;                  /* Passes so far, warm-up included */
+}Bench_Samples_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/* Benchmark functions - defined in their modules for the BENCH_ENABLE build */
+#define BENCH_CFG_BENCHMARK(id, name, function)     void function(void);
+#define BENCH_CFG_PROBE(id, name)
+    BENCH_CFG_TABLE
+#undef BENCH_CFG_BENCHMARK
+#undef BENCH_CFG_PROBE
+
+static void Bench_Sort(uint32_t* cycles, uint32_t num);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static const char* const Bench_Name[Bench_Max] =
+{
+    #define BENCH_CFG_BENCHMARK(id, name, function)     [id] = (name),
+    #define BENCH_CFG_PROBE(id, name)                   [id] = (name),
+        BENCH_CFG_TABLE
+    #undef BENCH_CFG_BENCHMARK
+    #undef BENCH_CFG_PROBE
+};
+
+/* NULL for probes */
+static const Bench_Function_t Bench_Function[Bench_Max] =
+{
+    #define BENCH_CFG_BENCHMARK(id, name, function)     [id] = (function),
+    #define BENCH_CFG_PROBE(id, name)                   [id] = NULL,
+        BENCH_CFG_TABLE
+    #undef BENCH_CFG_BENCHMARK
+    #undef BENCH_CFG_PROBE
+};
+
+static Bench_Samples_t Bench_Samples[Bench_Max];
+static uint32_t Bench_Sorted[BENCH_REPETITIONS];    /* Bench_GetResult working buffer */
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Run the benchmark - warm-up and repetitions in a row, probes are not affected
+ *
+ * \param[in] id Benchmark id
+ * 
+ * \retval None
+ */
+void Bench_Run(Bench_Id_t id)
+{
+    uint64_t start;
+
+    if((id < Bench_Max) && (Bench_Function[id] != NULL))
+    {
+        for(uint32_t i = 0U; i < (BENCH_WARMUP + BENCH_REPETITIONS); i++)
+        {
+            start = Dwt_GetCycles();
+            Bench_Function[id]();
+            Bench_Record(id, (uint32_t)(Dwt_GetCycles() - start));
+        }
+    }
+}
+
+/*!	
+ * \brief Record one pass - can be called from ISR, further passes are ignored once complete
+ *
+ * \param[in] id Benchmark id
+ * \param[in] cycles Measured cycles
+ * 
+ * \retval None
+ */
+void Bench_Record(Bench_Id_t id, uint32_t cycles)
+{
+    Bench_Samples_t* samples = &Bench_Samples[id];
+    uint32_t count = atomic_load_explicit(&samples->count, memory_order_relaxed);
+
+    if(count < (BENCH_WARMUP + BENCH_REPETITIONS))
+    {
+        if(count >= BENCH_WARMUP)
+        {
+            samples->cycles[count - BENCH_WARMUP] = cycles;
+        }
+
+        /* The sample is written before the reader may see it */
+        atomic_store_explicit(&samples->count, count + 1U, memory_order_release);
+    }
+}
+
+/*!	
+ * \brief Check if all repetitions were measured
+ *
+ * \param[in] id Benchmark id
+ * 
+ * \retval true if complete
+ */
+bool Bench_IsComplete(Bench_Id_t id)
+{
+    return (atomic_load_explicit(&Bench_Samples[id].count, memory_order_acquire) >= (BENCH_WARMUP + BENCH_REPETITIONS));
+}
+
+/*!	
+ * \brief Get statistics of the measured passes - incomplete probes give the passes so far.
+ *        Not reentrant, one reporting task only.
+ *
+ * \param[in] id Benchmark id
+ * \param[out] result Statistics, 0 cycles if nothing was measured
+ * 
+ * \retval None
+ */
+void Bench_GetResult(Bench_Id_t id, Bench_Result_t* result)
+{
+    uint32_t count = atomic_load_explicit(&Bench_Samples[id].count, memory_order_acquire);
+    uint32_t num = (count > BENCH_WARMUP) ? (count - BENCH_WARMUP) : 0U;
+
+    result->name = Bench_Name[id];
+    result->samples = num;
+    result->min = 0U;
+    result->median = 0U;
+    result->max = 0U;
+
+    if(num > 0U)
+    {
+        for(uint32_t i = 0U; i < num; i++)
+        {
+            Bench_Sorted[i] = Bench_Samples[id].cycles[i];
+        }
+
+        Bench_Sort(Bench_Sorted, num);
+
+        result->min = Bench_Sorted[0];
+        result->median = Bench_Sorted[num / 2U];
+        result->max = Bench_Sorted[num - 1U];
+    }
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Insertion sort - BENCH_REPETITIONS is small
+ *
+ * \param[in,out] cycles Values to sort in ascending order
+ * \param[in] num Number of values
+ * 
+ * \retval None
+ */
+static void Bench_Sort(uint32_t* cycles, uint32_t num)
+{
+    uint32_t value;
+    uint32_t j;
+
+    for(uint32_t i = 1U; i < num; i++)
+    {
+        value = cycles[i];
+
+        for(j = i; (j > 0U) && (cycles[j - 1U] > value); j--)
+        {
+            cycles[j] = cycles[j - 1U];
+        }
+
+        cycles[j] = value;
+    }
+}
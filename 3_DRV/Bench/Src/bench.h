@@ -0,0 +1,86 @@
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+/* 
+ * Micro-benchmark registry - cycles of the benchmarks and probes listed in BENCH_CFG_TABLE, measured
+ * with the DWT cycle counter. Only the benchmark build (BENCH_ENABLE) contains the harness, in other
+ * builds the probes compile to nothing.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "bench_cfg.h"
+#include "dwt.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#if (BENCH_ENABLE == 1U)
+
+/*!	
+ * \brief Start of the measured code - one probe per block
+ *
+ * \param[in] id Probe id from BENCH_CFG_TABLE
+ */
+#define BENCH_PROBE_BEGIN(id)       const uint64_t bench_probe_start = Dwt_GetCycles()
+
+/*!	
+ * \brief End of the measured code
+ *
+ * \param[in] id Probe id from BENCH_CFG_TABLE
+ */
+#define BENCH_PROBE_END(id)         Bench_Record((id), (uint32_t)(Dwt_GetCycles() - bench_probe_start))
+
+#else
+
+#define BENCH_PROBE_BEGIN(id)       ((void)0)
+#define BENCH_PROBE_END(id)         ((void)0)
+
+#endif
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    #define BENCH_CFG_BENCHMARK(id, name, function)     id,
+    #define BENCH_CFG_PROBE(id, name)                   id,
+        BENCH_CFG_TABLE
+    #undef BENCH_CFG_BENCHMARK
+    #undef BENCH_CFG_PROBE
+    Bench_Max
+}Bench_Id_t;
+
+/* Statistics of the measured runs/passes */
+typedef struct
+{
+    const char* name;
+    uint32_t samples;           /* Up to BENCH_REPETITIONS */
+    uint32_t min;               /* Cycles */
+    uint32_t median;            /* Cycles */
+    uint32_t max;               /* Cycles */
+}Bench_Result_t;
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Bench_Run(Bench_Id_t id);
+void Bench_Record(Bench_Id_t id, uint32_t cycles);
+bool Bench_IsComplete(Bench_Id_t id);
+void Bench_GetResult(Bench_Id_t id, Bench_Result_t* result);
+
+#endif  /* _BENCH_H_ */
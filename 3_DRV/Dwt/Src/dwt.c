@@ -0,0 +1,133 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "dwt.h"
+#include "snapshot.h"
+#include "stm32f7xx.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define DWT_LAR_UNLOCK_KEY          (0xC5ACCE55U)   /* Write access key of the DWT registers (Cortex-M7) */
+#define DWT_NS_IN_S                 (1000000000ULL)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef struct
+{
+    uint32_t wraps;             /* Upper 32 bits of the extended counter */
+    uint32_t cycles;            /* CYCCNT value of the last update - wrap detection */
+} Dwt_State_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static SNAPSHOT_TYPE(Dwt_State_t) Dwt_State;     /* Written by Dwt_Update only, read lock-free */
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief DWT cycle counter initialization function - should be called after the clock configuration
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Dwt_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = DWT_LAR_UNLOCK_KEY;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Dwt_State.sequence = 0U;
+    Dwt_State.buf[0].wraps = 0U;
+    Dwt_State.buf[0].cycles = 0U;
+}
+
+/*!	
+ * \brief Update the wrap count of the cycle counter - the only writer of the upper part, called from
+ *        SysTick_Handler. Has to run at least once per CYCCNT wrap (~19.9 s at 216 MHz).
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Dwt_Update(void)
+{
+    const Dwt_State_t* last = Snapshot_ReadBuf(&Dwt_State);
+    Dwt_State_t* next = Snapshot_WriteBuf(&Dwt_State);
+    uint32_t cycles = DWT->CYCCNT;
+
+    next->wraps = (cycles < last->cycles) ? (last->wraps + 1U) : last->wraps;
+    next->cycles = cycles;
+
+    Snapshot_Publish(&Dwt_State);
+}
+
+/*!	
+ * \brief Get cycle counter extended to 64 bits - can be called from ISR and tasks, lock-free.
+ *        The upper part is taken from the last Dwt_Update, a wrap since then is detected here.
+ *        Retries only when Dwt_Update published during the read.
+ *
+ * \param[in] None
+ * 
+ * \retval Cycles since Dwt_Init
+ */
+uint64_t Dwt_GetCycles(void)
+{
+    Dwt_State_t state;
+    uint32_t sequence;
+    uint32_t cycles;
+
+    do
+    {
+        sequence = Dwt_State.sequence;
+        __DMB();
+        state = Dwt_State.buf[sequence & 1U];
+        cycles = DWT->CYCCNT;
+        __DMB();
+    } while(sequence != Dwt_State.sequence);
+
+    if(cycles < state.cycles)
+    {
+        state.wraps++;
+    }
+
+    return ((uint64_t)state.wraps << 32U) | cycles;
+}
+
+/*!	
+ * \brief Convert cycles into nanoseconds - 64-bit division, should not be used in ISR
+ *
+ * \param[in] cycles Cycles returned by Dwt_GetCycles
+ * 
+ * \retval Time in ns
+ */
+uint64_t Dwt_CyclesToNs(uint64_t cycles)
+{
+    uint64_t seconds = cycles / SystemCoreClock;
+    uint64_t remainder = cycles % SystemCoreClock;
+
+    /* Split - cycles * 10^9 would overflow after ~85 s */
+    return (seconds * DWT_NS_IN_S) + ((remainder * DWT_NS_IN_S) / SystemCoreClock);
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
@@ -0,0 +1,34 @@
+#ifndef _DWT_H_
+#define _DWT_H_
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Dwt_Init(void);
+void Dwt_Update(void);
+uint64_t Dwt_GetCycles(void);
+uint64_t Dwt_CyclesToNs(uint64_t cycles);
+
+#endif  /* _DWT_H_ */
@@ -9,72 +9,177 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include "cmsis_os.h"
 #include "i2c.h"
+#include "ina226_reg.h"
+#include "dwt.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
-#define INA226_I2C_ADDR                     (0x40)
+/*
+ * I2C transport selection:
+ * 0 - interrupt driven transfers (one interrupt per byte)
+ * 1 - DMA transfers (I2C1_RX - DMA1 Stream0, I2C1_TX - DMA1 Stream6). D-cache is not enabled
+ *     in this project, so transfer buffers need no cache maintenance.
+ */
+#define INA226_CFG_TRANSPORT_DMA            (0U)
+
+#if (INA226_CFG_TRANSPORT_DMA == 1U)
+
+/*!	
+ * \brief I2C receive function
+ *
+ * \param[in] addr 7-bit I2C address of the device
+ * \param[in] buf_ptr Buffer pointer for reception data
+ * \param[in] size Size of data to receive
+ * 
+ * \retval None
+ */
+#define INA226_Receive(addr, buf_ptr, size)     (HAL_I2C_Master_Receive_DMA(&hi2c1, ((addr) << 1U), buf_ptr, size))
+
+/*!	
+ * \brief I2C transmit function
+ *
+ * \param[in] addr 7-bit I2C address of the device
+ * \param[in] buf_ptr Buffer pointer for transmission data
+ * \param[in] size Size of data to transmit
+ * 
+ * \retval None
+ */
+#define INA226_Transmit(addr, buf_ptr, size)    (HAL_I2C_Master_Transmit_DMA(&hi2c1, ((addr) << 1U), buf_ptr, size))
+
+#else
 
 /*!	
  * \brief I2C receive function
  *
+ * \param[in] addr 7-bit I2C address of the device
  * \param[in] buf_ptr Buffer pointer for reception data
  * \param[in] size Size of data to receive
  * 
  * \retval None
  */
-#define INA226_Receive(buf_ptr, size)       (HAL_I2C_Master_Receive_IT(&hi2c1, (INA226_I2C_ADDR << 1U), buf_ptr, size))
+#define INA226_Receive(addr, buf_ptr, size)     (HAL_I2C_Master_Receive_IT(&hi2c1, ((addr) << 1U), buf_ptr, size))
 
 /*!	
  * \brief I2C transmit function
  *
+ * \param[in] addr 7-bit I2C address of the device
  * \param[in] buf_ptr Buffer pointer for transmission data
  * \param[in] size Size of data to transmit
  * 
  * \retval None
  */
-#define INA226_Transmit(buf_ptr, size)      (HAL_I2C_Master_Transmit_IT(&hi2c1, (INA226_I2C_ADDR << 1U), buf_ptr, size))
+#define INA226_Transmit(addr, buf_ptr, size)    (HAL_I2C_Master_Transmit_IT(&hi2c1, ((addr) << 1U), buf_ptr, size))
+
+#endif
+
+/*!	
+ * \brief Timestamp of completed measurements - called from ISR, conversion is left to the upper layer
+ *
+ * \param[in] None
+ * 
+ * \retval CPU cycles (64-bit)
+ */
+#define INA226_GetTimestamp()               (Dwt_GetCycles())
+
+/*!	
+ * \brief Abort the active transfer - the peripheral generates STOP and calls HAL_I2C_AbortCpltCallback
+ *
+ * \param[in] addr 7-bit I2C address of the device
+ * 
+ * \retval INA226_TRANSFER_OK - abort started, otherwise no transfer is active
+ */
+#define INA226_CFG_ABORT_TRANSFER(addr)     (HAL_I2C_Master_Abort_IT(&hi2c1, ((addr) << 1U)))
+
+/*
+ * Task side of INA226_Abort runs with the I2C interrupts masked
+ */
+#define INA226_CFG_ENTER_CRITICAL()         taskENTER_CRITICAL()
+#define INA226_CFG_EXIT_CRITICAL()          taskEXIT_CRITICAL()
 
 /*
- * Status codes
+ * I2C transfer start status - returned by INA226_Receive/INA226_Transmit when the transfer started
  */
-#define INA226_CODE_OK                  (0U)
-#define INA226_CODE_NOT_OK              (1U)
+#define INA226_TRANSFER_OK                  (HAL_OK)
+
+/*
+ * Initialization
+ */
+#define INA226_CFG_INIT_RETRIES             (3U)    /* Retries of one register write before the device is marked failed */
 
 /*
  * Configuration according to INA226 datasheet
  */
 
-/* Configuration Register (00h) */
+/* Configuration Register (00h)
+ *
+ * High-rate acquisition (HAL shunt mode): VSHCT = VBUSCT = 0x00 (140 us), AVG = 0x00 (1).
+ * MODE = 0x05 (Shunt Voltage, Continuous) converts only the shunt, bus voltage then keeps the last value.
+ */
 #define INA226_CFG_CONFIGURATION_MODE       (0x07)  /* Operating Mode - Shunt and Bus, Continuous */
 #define INA226_CFG_CONFIGURATION_VSHCT      (0x07)  /* Shunt Voltage Conversion Time - 8.244 ms */
 #define INA226_CFG_CONFIGURATION_VBUSCT     (0x07)  /* Bus Voltage Conversion Time - 8.244 ms */
 #define INA226_CFG_CONFIGURATION_AVG        (0x01)  /* Averaging Mode - 4 */
 #define INA226_CFG_CONFIGURATION_RST        (0x00)  /* Reset Bit - 0 */
 
-/* Calibration Register (05h)  
+#define INA226_CFG_CONFIGURATION            ((INA226_CFG_CONFIGURATION_MODE << INA226_POS_CONFIGURATION_MODE) | \
+                                             (INA226_CFG_CONFIGURATION_VSHCT << INA226_POS_CONFIGURATION_VSHCT) | \
+                                             (INA226_CFG_CONFIGURATION_VBUSCT << INA226_POS_CONFIGURATION_VBUSCT) | \
+                                             (INA226_CFG_CONFIGURATION_AVG << INA226_POS_CONFIGURATION_AVG) | \
+                                             (INA226_CFG_CONFIGURATION_RST << INA226_POS_CONFIGURATION_RST))
+
+/* Calibration Register (05h) and LSBs of the results - derived from the shunt resistance and the max expected
+ * current (MEC), the HAL converts the results with the same values
  *
- * Max expected current (MEC) - 1.024A 
- * Shunt register (SR) - 0.1 Ohm 
- * CAL = 0.00512 /((MEC / 2^15) * SR) = 16 38.4 (0x0666)
+ * Current LSB = MEC / 2^15
+ * Power LSB = 25 * Current LSB
+ * CAL = 0.00512 / (Current LSB * Rshunt)
  */
-#define INA226_CFG_CALIBRATION              (0x0666)
+#define INA226_CFG_SHUNT_RESISTANCE_UOHM    (100000ULL)     /* Shunt resistance - 0.1 Ohm */
+#define INA226_CFG_MAX_CURRENT_UA           (1024000ULL)    /* Max expected current - 1.024 A */
+
+#define INA226_CFG_CURRENT_LSB_NA           ((INA226_CFG_MAX_CURRENT_UA * 1000ULL) / INA226_CURRENT_LSB_DIVIDER)     /* 31250 nA */
+#define INA226_CFG_POWER_LSB_NW             (INA226_POWER_LSB_RATIO * INA226_CFG_CURRENT_LSB_NA)                    /* 781250 nW */
+#define INA226_CFG_CALIBRATION              (INA226_CALIBRATION_SCALE / \
+                                             (INA226_CFG_CURRENT_LSB_NA * INA226_CFG_SHUNT_RESISTANCE_UOHM))        /* 1638 (0x0666) */
 
 /* Mask/Enable Register (06h) */
 #define INA226_CFG_MASK_ENABLE_LEN      (0x00)  /* Transparent (default) */
 #define INA226_CFG_MASK_ENABLE_APOL     (0x00)  /* Normal (active-low open collector) (default) */
 
-#define INA226_CFG_MASK_ENABLE_CNVR     (0x00)  /* Conversion Ready - DISABLED*/
+#define INA226_CFG_MASK_ENABLE_CNVR     (0x01)  /* Conversion Ready - ENABLED, must match HAL_ENERGY_MONITOR_CNVR_MODE */
 #define INA226_CFG_MASK_ENABLE_POL      (0x01)  /* Power Over-Limit - ENABLED */
 #define INA226_CFG_MASK_ENABLE_BUL      (0x00)  /* Bus Voltage Under-Voltage - DISABLED */
 #define INA226_CFG_MASK_ENABLE_BOL      (0x00)  /* Bus Voltage Over-Voltage - DISABLED */
 #define INA226_CFG_MASK_ENABLE_SUL      (0x00)  /* Shunt Voltage Under-Voltage - DISABLED */
 #define INA226_CFG_MASK_ENABLE_SOL      (0x00)  /* Shunt Voltage Over-Voltage - DISABLED */
 
+/* Default Mask/Enable Register value - used by the device table */
+#define INA226_CFG_MASK_ENABLE          ((INA226_CFG_MASK_ENABLE_LEN << INA226_POS_MASK_ENABLE_LEN) | \
+                                         (INA226_CFG_MASK_ENABLE_APOL << INA226_POS_MASK_ENABLE_APOL) | \
+                                         (INA226_CFG_MASK_ENABLE_CNVR << INA226_POS_MASK_ENABLE_CNVR) | \
+                                         (INA226_CFG_MASK_ENABLE_POL << INA226_POS_MASK_ENABLE_POL) | \
+                                         (INA226_CFG_MASK_ENABLE_BUL << INA226_POS_MASK_ENABLE_BUL) | \
+                                         (INA226_CFG_MASK_ENABLE_BOL << INA226_POS_MASK_ENABLE_BOL) | \
+                                         (INA226_CFG_MASK_ENABLE_SUL << INA226_POS_MASK_ENABLE_SUL) | \
+                                         (INA226_CFG_MASK_ENABLE_SOL << INA226_POS_MASK_ENABLE_SOL))
+
 /* Alert Limit Register (07h) */
-#define INA226_CFG_ALERT_LIMIT              (0x0066) // 80mW - Power Over-Limit threshold 
+#define INA226_CFG_ALERT_POWER_MW           (80ULL)         /* Power Over-Limit threshold - 80 mW */
+
+#define INA226_CFG_ALERT_LIMIT              ((INA226_CFG_ALERT_POWER_MW * 1000000ULL) / INA226_CFG_POWER_LSB_NW)   /* 102 (0x0066) */
+
+/*
+ * Devices on the bus: name, I2C address, calibration, mask/enable, alert limit - one channel per entry,
+ * up to INA226_MAX_DEVICES. A build may provide its own table (e.g. the multi-device host simulation).
+ */
+#ifndef INA226_CFG_DEVICE_TABLE
+#define INA226_CFG_DEVICE_TABLE  \
+    INA226_CFG_DEVICE(INA226_Channel0, 0x40, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)
+#endif
 
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
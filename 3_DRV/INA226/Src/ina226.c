@@ -2,9 +2,12 @@
  ********************************************* Included files **********************************************
  ***********************************************************************************************************/
 
+#include <stddef.h>
 #include "ina226_reg.h"
 #include "ina226_cfg.h"
 #include "ina226.h"
+#include "snapshot.h"
+#include "log.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
@@ -14,6 +17,8 @@
 #define INA226_REG_SIZE  (2U)
 #define INA226_BUF_SIZE  (3U)
 
+#define INA226_INIT_STEPS (4U)   /* Configuration, Calibration, Mask/Enable, Alert Limit */
+
 /*!	
  * \brief Get most significant byte
  *
@@ -53,9 +58,29 @@ typedef enum
     INA226_Uninitialized = 0,
     INA226_Ready,
     INA226_BusyTx,
-    INA226_BusyRx
+    INA226_BusyRx,
+    INA226_Aborting     /* Abort requested, the bus is released when the peripheral confirms it */
 }INA226_Status_t;
 
+/*
+ * Cause of a failed transfer
+ */
+typedef enum
+{
+    INA226_ErrorBus = 0,    /* Reported by the I2C peripheral (NACK, arbitration lost, bus error) */
+    INA226_ErrorTimeout     /* Not completed in time, aborted by the upper layer */
+}INA226_Error_t;
+
+/*
+ * Device state
+ */
+typedef enum
+{
+    INA226_DevUninitialized = 0,
+    INA226_DevReady,
+    INA226_DevFailed    /* Not responding - skipped by measurements */
+}INA226_DevState_t;
+
 /*
  * Transfer data
  */
@@ -70,33 +95,59 @@ typedef union
 }INA226_Transfer_t;
 
 /*
- * Results data
+ * Results data shared between the I2C callbacks (writer) and the upper layer (readers)
  */
-typedef struct 
-{
-    uint16_t shunt_voltage;
-    uint16_t bus_voltage;
-    uint16_t power;
-    uint16_t current;
-}INA226_Results_t;
+typedef SNAPSHOT_TYPE(INA226_Results_t) INA226_Snapshot_t;
 
 /*
  * All device information
  */
 typedef struct 
 {
-    volatile INA226_Status_t status;
+    uint8_t i2c_addr;
+    uint16_t configuration;
+    uint16_t calibration;
+    uint16_t mask_enable;
+    uint16_t alert_limit;
+    INA226_DevState_t state;
+    uint8_t init_step;
+    uint8_t retries;
+    uint8_t reg_pointer;        /* Register the device pointer register is set to */
+    bool reg_pointer_valid;
     INA226_Transfer_t transfer;
-    INA226_Results_t results;
+    INA226_Snapshot_t results;
 }INA226_Device_t;
 
+/*
+ * I2C bus information - all devices share one bus, so only one transfer can be active
+ */
+typedef struct 
+{
+    volatile INA226_Status_t status;
+    INA226_Status_t aborted_status;             /* Status of the transfer being aborted */
+    INA226_Device_t* active_dev;
+    uint8_t seq_regs[INA226_SEQUENCE_MAX_LEN];  /* Registers to read back-to-back */
+    uint8_t seq_len;
+    uint8_t seq_idx;
+    INA226_SequenceCb_t seq_cb;
+    uint8_t init_channel;                       /* Device being configured, INA226_ChannelMax when done */
+    INA226_InitCb_t init_cb;
+}INA226_Bus_t;
+
 /***********************************************************************************************************
  **************************************** Local function prototypes ****************************************
  ***********************************************************************************************************/
 
+static void INA226_InitStep(void);
+static void INA226_InitError(void);
+static void INA226_HandleError(INA226_Error_t cause);
+static void INA226_Release(INA226_Status_t status);
+static void INA226_ReleaseAborted(void);
 static uint8_t INA226_Write(INA226_Device_t* dev);
 static uint8_t INA226_Read(INA226_Device_t* dev);
-static void INA226_CollectResult(void);
+static uint8_t INA226_StartRead(INA226_Device_t* dev);
+static uint8_t INA226_GetRegAddr(INAA226_DataType_t data_type);
+static void INA226_CollectResult(INA226_Device_t* dev);
 
 /***********************************************************************************************************
  ******************************************** Exported objects *********************************************
@@ -106,124 +157,203 @@ static void INA226_CollectResult(void);
  ********************************************* Local objects ***********************************************
  ***********************************************************************************************************/
 
-static INA226_Device_t INA226_Device;
+_Static_assert(INA226_ChannelMax <= INA226_MAX_DEVICES, "Too many INA226 devices on one I2C bus");
+
+/* Configuration checked against the register layout */
+_Static_assert(INA226_CFG_CONFIGURATION_MODE <= INA226_MAX_CONFIGURATION_MODE, "Invalid INA226 operating mode");
+_Static_assert(INA226_CFG_CONFIGURATION_VSHCT <= INA226_MAX_CONFIGURATION_VSHCT, "Invalid INA226 shunt conversion time");
+_Static_assert(INA226_CFG_CONFIGURATION_VBUSCT <= INA226_MAX_CONFIGURATION_VBUSCT, "Invalid INA226 bus conversion time");
+_Static_assert(INA226_CFG_CONFIGURATION_AVG <= INA226_MAX_CONFIGURATION_AVG, "Invalid INA226 averaging mode");
+_Static_assert(INA226_CFG_CONFIGURATION_RST <= INA226_MAX_CONFIGURATION_RST, "Invalid INA226 reset bit");
+_Static_assert(INA226_CFG_CURRENT_LSB_NA > 0U, "INA226 max expected current too low");
+_Static_assert((INA226_CFG_CALIBRATION > 0U) && (INA226_CFG_CALIBRATION <= INA226_CALIBRATION_MAX), \
+               "INA226 calibration out of range - check the shunt resistance and the max expected current");
+_Static_assert(INA226_CFG_ALERT_LIMIT <= 0xFFFFU, "INA226 alert limit out of range");
+
+static INA226_Device_t INA226_Device[INA226_ChannelMax] =
+{
+    #define INA226_CFG_DEVICE(name, addr, cal, mask, limit) { \
+        .i2c_addr=addr, \
+        .configuration=INA226_CFG_CONFIGURATION, \
+        .calibration=cal, \
+        .mask_enable=mask, \
+        .alert_limit=limit},
+        INA226_CFG_DEVICE_TABLE
+    #undef INA226_CFG_DEVICE
+};
+
+static INA226_Bus_t INA226_Bus;
 
 /***********************************************************************************************************
  ******************************************* Exported functions ********************************************
  ***********************************************************************************************************/
 
 /*!	
- * \brief INA226 initialization function
+ * \brief INA226 initialization function - starts configuration of all devices from the device table.
+ *        The function does not block, registers are written one by one from the I2C callbacks.
+ *        A write which cannot be started or is aborted is retried on the next INA226_Abort, a device
+ *        which does not respond after INA226_CFG_INIT_RETRIES is marked failed and skipped.
  *
- * \param[in] None
+ * \param[in] complete_cb Callback called after every register write and when all devices are configured
+ *                        or failed, can be NULL
  * 
  * \retval None
  */
-void INA226_Init(void)
+void INA226_Init(INA226_InitCb_t complete_cb)
 {
-    uint16_t tx_data = 0U;
-    uint8_t status = INA226_CODE_OK;
-
-    INA226_Device.status = INA226_Ready;
-
-    /* Configuration Register */
-    tx_data = ((INA226_CFG_CONFIGURATION_MODE << INA226_POS_CONFIGURATION_MODE) | \
-               (INA226_CFG_CONFIGURATION_VSHCT << INA226_POS_CONFIGURATION_VSHCT)  | \
-               (INA226_CFG_CONFIGURATION_VBUSCT << INA226_POS_CONFIGURATION_VBUSCT)  | \
-               (INA226_CFG_CONFIGURATION_AVG << INA226_POS_CONFIGURATION_AVG)  | \
-               (INA226_CFG_CONFIGURATION_RST << INA226_POS_CONFIGURATION_RST));
-       
-    INA226_Device.transfer.field.data[0] = INA226_GetMSByte(tx_data);
-    INA226_Device.transfer.field.data[1] = INA226_GetLSByte(tx_data);
-    INA226_Device.transfer.field.reg_Addr = INA226_REG_CONFIGURATION;
+    for(uint8_t i = 0; i < (uint8_t)INA226_ChannelMax; i++)
+    {
+        INA226_Device[i].state = INA226_DevUninitialized;
+        INA226_Device[i].init_step = 0U;
+        INA226_Device[i].retries = 0U;
+        INA226_Device[i].reg_pointer_valid = false;
+    }
 
-    status = INA226_Write(&INA226_Device);
+    INA226_Bus.active_dev = NULL;
+    INA226_Bus.init_channel = 0U;
+    INA226_Bus.init_cb = complete_cb;
+    INA226_Bus.status = INA226_Ready;
 
-    /* Wait for transmision complete */
-    while(INA226_Device.status != INA226_Ready);
+    INA226_InitStep();
+}
 
-    /* Calibration Register (05h) */
-    tx_data = INA226_CFG_CALIBRATION;
-    INA226_Device.transfer.field.data[0]  = INA226_GetMSByte(tx_data);
-    INA226_Device.transfer.field.data[1] = INA226_GetLSByte(tx_data);
-    INA226_Device.transfer.field.reg_Addr = INA226_REG_CALIBRATION;
+/*!	
+ * \brief INA226 reconfiguration function - the configuration register of all devices is changed
+ *        and all registers are written again as in INA226_Init. Devices are not read until done.
+ *
+ * \param[in] configuration New configuration register value (conversion times, averaging, mode)
+ * \param[in] complete_cb Callback called after every register write and when all devices are configured
+ *                        or failed, can be NULL
+ * 
+ * \retval Status code - not OK while a transfer is active
+ */
+uint8_t INA226_Reconfigure(uint16_t configuration, INA226_InitCb_t complete_cb)
+{
+    uint8_t ret_val = INA226_CODE_OK;
 
-    if(status == INA226_CODE_OK)
+    if(INA226_Bus.status != INA226_Ready)
     {
-        INA226_Write(&INA226_Device);
+        ret_val = INA226_CODE_NOT_OK;
     }
-    
-    /* Wait for transmision complete */
-    while(INA226_Device.status != INA226_Ready);
-
-    /* Mask/Enable Register (06h) */
-    tx_data = ((INA226_CFG_MASK_ENABLE_LEN << INA226_POS_MASK_ENABLE_LEN) | \
-               (INA226_CFG_MASK_ENABLE_APOL << INA226_POS_MASK_ENABLE_APOL) | \
-               (INA226_CFG_MASK_ENABLE_CNVR << INA226_POS_MASK_ENABLE_CNVR) | \
-               (INA226_CFG_MASK_ENABLE_POL << INA226_POS_MASK_ENABLE_POL) | \
-               (INA226_CFG_MASK_ENABLE_BUL << INA226_POS_MASK_ENABLE_BUL) | \
-               (INA226_CFG_MASK_ENABLE_BOL << INA226_POS_MASK_ENABLE_BOL) | \
-               (INA226_CFG_MASK_ENABLE_SUL << INA226_POS_MASK_ENABLE_SUL) | \
-               (INA226_CFG_MASK_ENABLE_SOL << INA226_POS_MASK_ENABLE_SOL));
-    INA226_Device.transfer.field.data[0] = INA226_GetMSByte(tx_data);
-    INA226_Device.transfer.field.data[1] = INA226_GetLSByte(tx_data);
-    INA226_Device.transfer.field.reg_Addr = INA226_REG_MASK_ENABLE;
-
-    if(status == INA226_CODE_OK)
+    else
     {
-        INA226_Write(&INA226_Device);
-    }
+        for(uint8_t i = 0; i < (uint8_t)INA226_ChannelMax; i++)
+        {
+            INA226_Device[i].configuration = configuration;
+        }
 
-    /* Wait for transmision complete */
-    while(INA226_Device.status != INA226_Ready);
+        INA226_Init(complete_cb);
+    }
 
-    /* Alert Limit Register (07h) */
-    tx_data = INA226_CFG_ALERT_LIMIT;
-    INA226_Device.transfer.field.data[0] = INA226_GetMSByte(tx_data);
-    INA226_Device.transfer.field.data[1] = INA226_GetLSByte(tx_data);
-    INA226_Device.transfer.field.reg_Addr = INA226_REG_ALERT_LIMIT;
+    return ret_val;
+}
 
-    if(status == INA226_CODE_OK)
-    {
-        INA226_Write(&INA226_Device);
-    }
+/*!	
+ * \brief Function returns initialization status
+ *
+ * \param[in] None
+ * 
+ * \retval true - all devices are configured or failed, otherwise false
+ */
+bool INA226_IsInitialized(void)
+{
+    return (INA226_Bus.status != INA226_Uninitialized) && (INA226_Bus.init_channel >= (uint8_t)INA226_ChannelMax);
+}
 
-    /* Wait for transmision complete */
-    while(INA226_Device.status != INA226_Ready);
+/*!	
+ * \brief Function returns device availability
+ *
+ * \param[in] channel Device to check
+ * 
+ * \retval true - device is configured and can be read, otherwise false
+ */
+bool INA226_IsAvailable(INA226_Channel_t channel)
+{
+    return (channel < INA226_ChannelMax) && (INA226_Device[channel].state == INA226_DevReady);
+}
 
+/*!	
+ * \brief Abort the active transfer - should be called from the task when a transfer has not completed
+ *        in the expected time. The transfer is stopped by the peripheral and the bus is released from
+ *        INA226_AbortCompleteCb, a late callback of the stopped transfer is ignored until then. Called
+ *        again while the abort is not confirmed, the bus is released at once. During initialization
+ *        the register write is retried after the release.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void INA226_Abort(void)
+{
+    INA226_CFG_ENTER_CRITICAL();
+    INA226_HandleError(INA226_ErrorTimeout);
+    INA226_CFG_EXIT_CRITICAL();
 }
 
 /*!	
  * \brief INA226 start measurement function
  *
+ * \param[in] channel Device to read
  * \param[in] data_type Data type to receive
  * 
  * \retval Status code
  */
-uint8_t INA226_ReadMeasurement(INAA226_DataType_t data_type)
+uint8_t INA226_ReadMeasurement(INA226_Channel_t channel, INAA226_DataType_t data_type)
 {
-    uint8_t ret_val;
+    return INA226_ReadSequence(channel, &data_type, 1U, NULL);
+}
 
-    switch (data_type)
+/*!	
+ * \brief INA226 start sequence function - all registers are read back-to-back from the I2C
+ *        callbacks, without involving any task between them
+ *
+ * \param[in] channel Device to read
+ * \param[in] data_types List of data types to receive
+ * \param[in] num Number of elements in the list (max INA226_SEQUENCE_MAX_LEN)
+ * \param[in] complete_cb Callback called from ISR when the whole sequence is read, failed or the bus is
+ *                        released after INA226_Abort, can be NULL
+ * 
+ * \retval Status code
+ */
+uint8_t INA226_ReadSequence(INA226_Channel_t channel, const INAA226_DataType_t* data_types, uint8_t num, \
+                            INA226_SequenceCb_t complete_cb)
+{
+    uint8_t ret_val = INA226_CODE_OK;
+    INA226_Device_t* dev;
+
+    if((!INA226_IsAvailable(channel)) || (num == 0U) || (num > INA226_SEQUENCE_MAX_LEN))
     {
-        case INA226_ShuntVoltage:
-            INA226_Device.transfer.field.reg_Addr = INA226_REG_SHUNT_VOLTAGE;
-            ret_val = INA226_Read(&INA226_Device);
-            break;
-        case INA226_BusVoltage:
-            INA226_Device.transfer.field.reg_Addr = INA226_REG_BUS_VOLTAGE;
-            ret_val = INA226_Read(&INA226_Device);
-            break;
-        case INA226_Power:
-            INA226_Device.transfer.field.reg_Addr = INA226_REG_POWER;
-            ret_val = INA226_Read(&INA226_Device);
-            break;
-        case INA226_Current:
-            INA226_Device.transfer.field.reg_Addr = INA226_REG_CURRENT;
-            ret_val = INA226_Read(&INA226_Device);
-            break;
-        default:
-            break;
+        ret_val = INA226_CODE_NOT_OK;
+    }
+    else if((INA226_Bus.status != INA226_Ready) || (!INA226_IsInitialized()))
+    {
+        ret_val = INA226_CODE_NOT_OK;  /* Bus is used by another sequence */
+    }
+    else
+    {
+        for(uint8_t i = 0; (i < num) && (ret_val == INA226_CODE_OK); i++)
+        {
+            INA226_Bus.seq_regs[i] = INA226_GetRegAddr(data_types[i]);
+
+            if(INA226_Bus.seq_regs[i] == INA226_REG_CONFIGURATION)
+            {
+                ret_val = INA226_CODE_NOT_OK;  /* Not a measurement register */
+            }
+        }
+
+        if(ret_val == INA226_CODE_OK)
+        {
+            INA226_Bus.seq_len = num;
+            INA226_Bus.seq_idx = 0U;
+            INA226_Bus.seq_cb = complete_cb;
+
+            /* Registers not read by this sequence keep the last values */
+            dev = &INA226_Device[channel];
+            *Snapshot_WriteBuf(&dev->results) = *Snapshot_ReadBuf(&dev->results);
+
+            dev->transfer.field.reg_Addr = INA226_Bus.seq_regs[0];
+            ret_val = INA226_Read(dev);
+        }
     }
 
     return ret_val;
@@ -232,30 +362,59 @@ uint8_t INA226_ReadMeasurement(INAA226_DataType_t data_type)
 /*!	
  * \brief Get result
  *
+ * \param[in] channel Device to return result of
  * \param[in] data_type Data type to return
  * 
  * \retval Result based on the data_type parameter.
  */
-uint16_t INA226_GetResult(INAA226_DataType_t data_type)
+uint16_t INA226_GetResult(INA226_Channel_t channel, INAA226_DataType_t data_type)
 {
     uint16_t ret_val = 0U;
+    INA226_Results_t results;
 
-    switch (data_type)
+    if(INA226_GetResults(channel, &results) == INA226_CODE_OK)
     {
-        case INA226_ShuntVoltage:
-            ret_val = INA226_Device.results.shunt_voltage;
-            break;
-        case INA226_BusVoltage:
-            ret_val = INA226_Device.results.bus_voltage;
-            break;
-        case INA226_Power:
-            ret_val = INA226_Device.results.power;
-            break;
-        case INA226_Current:
-            ret_val = INA226_Device.results.current;
-            break;
-        default:
-            break;
+        switch (data_type)
+        {
+            case INA226_ShuntVoltage:
+                ret_val = results.shunt_voltage;
+                break;
+            case INA226_BusVoltage:
+                ret_val = results.bus_voltage;
+                break;
+            case INA226_Power:
+                ret_val = results.power;
+                break;
+            case INA226_Current:
+                ret_val = results.current;
+                break;
+            case INA226_MaskEnable:
+                ret_val = results.mask_enable;
+                break;
+            default:
+                break;
+        }
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Get coherent set of results - all values come from the same register sequence
+ *
+ * \param[in] channel Device to return results of
+ * \param[out] results Pointer to store results
+ * 
+ * \retval Status code
+ */
+uint8_t INA226_GetResults(INA226_Channel_t channel, INA226_Results_t* results)
+{
+    uint8_t ret_val = INA226_CODE_NOT_OK;
+
+    if(channel < INA226_ChannelMax)
+    {
+        Snapshot_Read(&INA226_Device[channel].results, results);
+        ret_val = INA226_CODE_OK;
     }
 
     return ret_val;
@@ -270,10 +429,37 @@ uint16_t INA226_GetResult(INAA226_DataType_t data_type)
  */
 void INA226_ReadCompleteCb(void)
 {
-    if(INA226_Device.status == INA226_BusyRx)
+    INA226_Device_t* dev = INA226_Bus.active_dev;
+
+    if(INA226_Bus.status == INA226_BusyRx)
     {
-        INA226_Device.status = INA226_Ready;
-        INA226_CollectResult();
+        INA226_CollectResult(dev);
+        INA226_Bus.seq_idx++;
+
+        if(INA226_Bus.seq_idx < INA226_Bus.seq_len)
+        {
+            /* Chain next register of the sequence */
+            dev->transfer.field.reg_Addr = INA226_Bus.seq_regs[INA226_Bus.seq_idx];
+
+            if(INA226_StartRead(dev) != INA226_CODE_OK)
+            {
+                INA226_HandleError(INA226_ErrorBus);  /* Sequence failed */
+            }
+        }
+        else
+        {
+            /* Whole set is coherent - publish it */
+            Snapshot_WriteBuf(&dev->results)->timestamp = INA226_GetTimestamp();
+            Snapshot_WriteBuf(&dev->results)->sequence = Snapshot_ReadBuf(&dev->results)->sequence + 1U;
+            Snapshot_Publish(&dev->results);
+
+            INA226_Bus.status = INA226_Ready;
+
+            if(INA226_Bus.seq_cb != NULL)
+            {
+                INA226_Bus.seq_cb((INA226_Channel_t)(dev - INA226_Device), INA226_CODE_OK);
+            }
+        }
     }
 }
 
@@ -286,13 +472,27 @@ void INA226_ReadCompleteCb(void)
  */
 void INA226_WriteCompleteCb(void)
 {
-    if(INA226_Device.status == INA226_BusyTx)
+    INA226_Device_t* dev = INA226_Bus.active_dev;
+
+    if(INA226_Bus.status == INA226_BusyTx)
     {
-        INA226_Device.status = INA226_Ready;
+        /* Register write is used only by the initialization, it also sets the pointer register */
+        INA226_Bus.status = INA226_Ready;
+        dev->reg_pointer = dev->transfer.field.reg_Addr;
+        dev->reg_pointer_valid = true;
+        dev->init_step++;
+        dev->retries = 0U;
+        INA226_InitStep();
     }
-    else if(INA226_Device.status == INA226_BusyRx)
+    else if(INA226_Bus.status == INA226_BusyRx)
     {
-        INA226_Receive(INA226_Device.transfer.field.data, INA226_REG_SIZE);
+        dev->reg_pointer = dev->transfer.field.reg_Addr;
+        dev->reg_pointer_valid = true;
+
+        if(INA226_Receive(dev->i2c_addr, dev->transfer.field.data, INA226_REG_SIZE) != INA226_TRANSFER_OK)
+        {
+            INA226_HandleError(INA226_ErrorBus);  /* Sequence failed */
+        }
     }
     else
     {
@@ -300,10 +500,226 @@ void INA226_WriteCompleteCb(void)
     }
 }
 
+/*!	
+ * \brief I2C error callback (e.g. NACK from an absent device) - should be called from ISR
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void INA226_ErrorCb(void)
+{
+    INA226_HandleError(INA226_ErrorBus);
+}
+
+/*!	
+ * \brief I2C abort complete callback - should be called from ISR
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void INA226_AbortCompleteCb(void)
+{
+    if(INA226_Bus.status == INA226_Aborting)
+    {
+        INA226_ReleaseAborted();
+    }
+}
+
 /***********************************************************************************************************
  ******************************************** Local functions **********************************************
  ***********************************************************************************************************/
 
+/*!	
+ * \brief Initialization state machine - starts the next register write of the device being
+ *        configured. Called from the task on start and from the I2C callbacks afterwards.
+ *        A write which cannot be started counts as a retry and waits for INA226_Abort, so
+ *        a busy peripheral does not use up the retries of all devices at once.
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void INA226_InitStep(void)
+{
+    INA226_Device_t* dev;
+    uint16_t tx_data = 0U;
+    bool started = false;
+    bool retry = false;
+
+    while((!started) && (!retry) && (INA226_Bus.init_channel < (uint8_t)INA226_ChannelMax))
+    {
+        dev = &INA226_Device[INA226_Bus.init_channel];
+
+        if(dev->state == INA226_DevFailed)
+        {
+            INA226_Bus.init_channel++;
+        }
+        else if(dev->init_step >= INA226_INIT_STEPS)
+        {
+            dev->state = INA226_DevReady;
+            INA226_Bus.init_channel++;
+        }
+        else
+        {
+            switch (dev->init_step)
+            {
+                case 0U:
+                    dev->transfer.field.reg_Addr = INA226_REG_CONFIGURATION;
+                    tx_data = dev->configuration;
+                    break;
+                case 1U:
+                    dev->transfer.field.reg_Addr = INA226_REG_CALIBRATION;
+                    tx_data = dev->calibration;
+                    break;
+                case 2U:
+                    dev->transfer.field.reg_Addr = INA226_REG_MASK_ENABLE;
+                    tx_data = dev->mask_enable;
+                    break;
+                default:
+                    dev->transfer.field.reg_Addr = INA226_REG_ALERT_LIMIT;
+                    tx_data = dev->alert_limit;
+                    break;
+            }
+
+            dev->transfer.field.data[0] = INA226_GetMSByte(tx_data);
+            dev->transfer.field.data[1] = INA226_GetLSByte(tx_data);
+
+            if(INA226_Write(dev) == INA226_CODE_OK)
+            {
+                started = true;
+            }
+            else if(++dev->retries > INA226_CFG_INIT_RETRIES)
+            {
+                dev->state = INA226_DevFailed;
+            }
+            else
+            {
+                retry = true;  /* Started again by INA226_Abort */
+            }
+        }
+    }
+
+    /* Progress - the write is started, waits for a retry or all devices are done */
+    if(INA226_Bus.init_cb != NULL)
+    {
+        INA226_Bus.init_cb();
+    }
+}
+
+/*!	
+ * \brief Function handles failed register write during initialization - the write is retried,
+ *        after INA226_CFG_INIT_RETRIES the device is marked failed and the next one is configured
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void INA226_InitError(void)
+{
+    INA226_Device_t* dev = &INA226_Device[INA226_Bus.init_channel];
+
+    if(++dev->retries > INA226_CFG_INIT_RETRIES)
+    {
+        dev->state = INA226_DevFailed;
+    }
+
+    INA226_InitStep();
+}
+
+/*!	
+ * \brief Function handles I2C error or timeout of the active transfer - only bus errors are logged here,
+ *        timeouts are logged by the layer which detected them
+ *
+ * \param[in] cause Bus error reported by the peripheral or timeout
+ * 
+ * \retval None
+ */
+static void INA226_HandleError(INA226_Error_t cause)
+{
+    if(cause == INA226_ErrorBus)
+    {
+        (void)Log_Write(Log_I2cError, (INA226_Bus.active_dev != NULL) ? (int32_t)INA226_Bus.active_dev->i2c_addr : 0, \
+                        (int32_t)INA226_Bus.status, 0);
+    }
+
+    if(INA226_Bus.active_dev != NULL)
+    {
+        INA226_Bus.active_dev->reg_pointer_valid = false;  /* Unknown where the transfer stopped */
+    }
+
+    if((INA226_Bus.status == INA226_BusyTx) || (INA226_Bus.status == INA226_BusyRx))
+    {
+        if(cause == INA226_ErrorTimeout)
+        {
+            /* The transfer may still run - the bus is released when the peripheral stops it */
+            INA226_Bus.aborted_status = INA226_Bus.status;
+            INA226_Bus.status = INA226_Aborting;
+
+            if(INA226_CFG_ABORT_TRANSFER(INA226_Bus.active_dev->i2c_addr) != INA226_TRANSFER_OK)
+            {
+                INA226_ReleaseAborted();  /* Nothing to stop */
+            }
+        }
+        else
+        {
+            INA226_Release(INA226_Bus.status);
+        }
+    }
+    else if(INA226_Bus.status == INA226_Aborting)
+    {
+        INA226_ReleaseAborted();  /* Stopped with an error or abort not confirmed in time */
+    }
+    else if((cause == INA226_ErrorTimeout) && (INA226_Bus.status == INA226_Ready) && (!INA226_IsInitialized()))
+    {
+        INA226_InitStep();  /* Write could not be started - retry */
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*!	
+ * \brief Function releases the bus after a failed transfer - a failed register write is retried,
+ *        the owner of a failed sequence is notified at once, its results are not collected
+ *
+ * \param[in] status Status of the failed transfer
+ * 
+ * \retval None
+ */
+static void INA226_Release(INA226_Status_t status)
+{
+    INA226_Bus.status = INA226_Ready;
+
+    if(status == INA226_BusyTx)
+    {
+        INA226_InitError();
+    }
+    else if((status == INA226_BusyRx) && (INA226_Bus.seq_cb != NULL))
+    {
+        INA226_Bus.seq_cb((INA226_Channel_t)(INA226_Bus.active_dev - INA226_Device), INA226_CODE_NOT_OK);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*!	
+ * \brief Function releases the bus after an abort - the owner of the aborted sequence waits for the
+ *        release before it starts the next one
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+static void INA226_ReleaseAborted(void)
+{
+    INA226_Release(INA226_Bus.aborted_status);
+}
+
 /*!	
  * \brief INA226 write function
  *
@@ -315,14 +731,20 @@ static uint8_t INA226_Write(INA226_Device_t* dev)
 {
     uint8_t ret_val = INA226_CODE_OK;
 
-    if(dev->status != INA226_Ready)
+    if(INA226_Bus.status != INA226_Ready)
     {
         ret_val = INA226_CODE_NOT_OK;  /* Invalid transmission */
     }
     else
     {
-        dev->status = INA226_BusyTx;
-        INA226_Transmit(dev->transfer.buf, INA226_BUF_SIZE);
+        INA226_Bus.status = INA226_BusyTx;
+        INA226_Bus.active_dev = dev;
+
+        if(INA226_Transmit(dev->i2c_addr, dev->transfer.buf, INA226_BUF_SIZE) != INA226_TRANSFER_OK)
+        {
+            INA226_Bus.status = INA226_Ready;
+            ret_val = INA226_CODE_NOT_OK;
+        }
     }
 
     return ret_val;
@@ -339,14 +761,88 @@ static uint8_t INA226_Read(INA226_Device_t* dev)
 {
     uint8_t ret_val = INA226_CODE_OK;
 
-    if(dev->status != INA226_Ready)
+    if(INA226_Bus.status != INA226_Ready)
     {
         ret_val = INA226_CODE_NOT_OK;  /* Invalid reception */
     }
     else
     {
-        dev->status = INA226_BusyRx;
-        INA226_Transmit(&(dev->transfer.field.reg_Addr), INA226_ADDR_SIZE);
+        INA226_Bus.status = INA226_BusyRx;
+        INA226_Bus.active_dev = dev;
+
+        if(INA226_StartRead(dev) != INA226_CODE_OK)
+        {
+            INA226_Bus.status = INA226_Ready;
+            ret_val = INA226_CODE_NOT_OK;
+        }
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Function starts reading of the register set in the transfer data. The device keeps its
+ *        pointer register between reads, so the register address is sent only when the pointer
+ *        has to change - a repeated read of the same register is a receive-only transaction.
+ *
+ * \param[in] dev Device information object pointer
+ * 
+ * \retval Status code
+ */
+static uint8_t INA226_StartRead(INA226_Device_t* dev)
+{
+    uint8_t ret_val = INA226_CODE_OK;
+
+    if(dev->reg_pointer_valid && (dev->reg_pointer == dev->transfer.field.reg_Addr))
+    {
+        if(INA226_Receive(dev->i2c_addr, dev->transfer.field.data, INA226_REG_SIZE) != INA226_TRANSFER_OK)
+        {
+            ret_val = INA226_CODE_NOT_OK;
+        }
+    }
+    else
+    {
+        dev->reg_pointer_valid = false;  /* Valid again when the address write completes */
+
+        if(INA226_Transmit(dev->i2c_addr, &(dev->transfer.field.reg_Addr), INA226_ADDR_SIZE) != INA226_TRANSFER_OK)
+        {
+            ret_val = INA226_CODE_NOT_OK;
+        }
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Function returns register address of the measurement
+ *
+ * \param[in] data_type Data type
+ * 
+ * \retval Register address, INA226_REG_CONFIGURATION for invalid data type
+ */
+static uint8_t INA226_GetRegAddr(INAA226_DataType_t data_type)
+{
+    uint8_t ret_val = INA226_REG_CONFIGURATION;
+
+    switch (data_type)
+    {
+        case INA226_ShuntVoltage:
+            ret_val = INA226_REG_SHUNT_VOLTAGE;
+            break;
+        case INA226_BusVoltage:
+            ret_val = INA226_REG_BUS_VOLTAGE;
+            break;
+        case INA226_Power:
+            ret_val = INA226_REG_POWER;
+            break;
+        case INA226_Current:
+            ret_val = INA226_REG_CURRENT;
+            break;
+        case INA226_MaskEnable:
+            ret_val = INA226_REG_MASK_ENABLE;
+            break;
+        default:
+            break;
     }
 
     return ret_val;
@@ -355,25 +851,30 @@ static uint8_t INA226_Read(INA226_Device_t* dev)
 /*!	
  * \brief Function collects received data
  *
- * \param[in] None
+ * \param[in] dev Device information object pointer
  * 
  * \retval None
  */
-static void INA226_CollectResult(void)
+static void INA226_CollectResult(INA226_Device_t* dev)
 {
-    switch (INA226_Device.transfer.field.reg_Addr)
+    INA226_Results_t* results = Snapshot_WriteBuf(&dev->results);
+
+    switch (dev->transfer.field.reg_Addr)
     {
         case INA226_REG_SHUNT_VOLTAGE:
-            INA226_Device.results.shunt_voltage = INA226_ConcatenateBytes(INA226_Device.transfer.field.data);
+            results->shunt_voltage = INA226_ConcatenateBytes(dev->transfer.field.data);
             break;
         case INA226_REG_BUS_VOLTAGE:
-            INA226_Device.results.bus_voltage = INA226_ConcatenateBytes(INA226_Device.transfer.field.data);
+            results->bus_voltage = INA226_ConcatenateBytes(dev->transfer.field.data);
             break;
         case INA226_REG_POWER:
-            INA226_Device.results.power = INA226_ConcatenateBytes(INA226_Device.transfer.field.data);
+            results->power = INA226_ConcatenateBytes(dev->transfer.field.data);
             break;
         case INA226_REG_CURRENT:
-            INA226_Device.results.current = INA226_ConcatenateBytes(INA226_Device.transfer.field.data);
+            results->current = INA226_ConcatenateBytes(dev->transfer.field.data);
+            break;
+        case INA226_REG_MASK_ENABLE:
+            results->mask_enable = INA226_ConcatenateBytes(dev->transfer.field.data);
             break;
         default:
             break;
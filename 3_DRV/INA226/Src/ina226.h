@@ -6,11 +6,32 @@
  ***********************************************************************************************************/
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "ina226_cfg.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
  ***********************************************************************************************************/
 
+/*
+ * Configuration
+ */
+
+#define INA226_MAX_DEVICES      (16U)   /* A0/A1 pins allow 16 addresses (0x40 - 0x4F) on one bus */
+#define INA226_SEQUENCE_MAX_LEN (4U)    /* Max number of registers read in one sequence */
+
+/*
+ * Status codes
+ */
+#define INA226_CODE_OK                  (0U)
+#define INA226_CODE_NOT_OK              (1U)
+
+/*
+ * Mask/Enable Register flags - returned by INA226_GetResult(channel, INA226_MaskEnable)
+ */
+#define INA226_FLAG_CONVERSION_READY    (1U << 3U)  /* CVRF - new conversion available */
+#define INA226_FLAG_ALERT_FUNCTION      (1U << 4U)  /* AFF - alert function limit exceeded */
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
@@ -20,9 +41,45 @@ typedef enum
     INA226_ShuntVoltage = 0,
     INA226_BusVoltage,
     INA226_Power,
-    INA226_Current
+    INA226_Current,
+    INA226_MaskEnable   /* Reading clears the conversion ready flag and releases the ALERT pin */
 }INAA226_DataType_t;
 
+typedef enum
+{
+    #define INA226_CFG_DEVICE(name, addr, cal, mask, limit)   name,
+        INA226_CFG_DEVICE_TABLE
+    #undef INA226_CFG_DEVICE
+    INA226_ChannelMax
+}INA226_Channel_t;
+
+/*
+ * Results data - one coherent set, published when the whole register sequence is read
+ */
+typedef struct 
+{
+    uint16_t shunt_voltage;
+    uint16_t bus_voltage;
+    uint16_t power;
+    uint16_t current;
+    uint16_t mask_enable;
+    uint64_t timestamp;     /* Time of the sequence completion, see INA226_GetTimestamp */
+    uint32_t sequence;      /* Number of completed sequences */
+}INA226_Results_t;
+
+/*
+ * Sequence complete callback - called from ISR when all registers of a sequence are read (INA226_CODE_OK),
+ * and when the sequence failed on an I2C error or the bus is released after INA226_Abort of the sequence
+ * (INA226_CODE_NOT_OK, results are not published then)
+ */
+typedef void (*INA226_SequenceCb_t)(INA226_Channel_t channel, uint8_t status);
+
+/*
+ * Initialization progress callback - called (usually from ISR) after every register write and when all devices
+ * are configured or failed, see INA226_IsInitialized
+ */
+typedef void (*INA226_InitCb_t)(void);
+
 /***********************************************************************************************************
  ********************************************* Exported objects ********************************************
  ***********************************************************************************************************/
@@ -34,14 +91,23 @@ typedef enum
 /*
  * API
  */
-void INA226_Init(void);
-uint8_t INA226_ReadMeasurement(INAA226_DataType_t data_type);
-uint16_t INA226_GetResult(INAA226_DataType_t data_type);
+void INA226_Init(INA226_InitCb_t complete_cb);
+uint8_t INA226_Reconfigure(uint16_t configuration, INA226_InitCb_t complete_cb);
+bool INA226_IsInitialized(void);
+bool INA226_IsAvailable(INA226_Channel_t channel);
+void INA226_Abort(void);
+uint8_t INA226_ReadMeasurement(INA226_Channel_t channel, INAA226_DataType_t data_type);
+uint8_t INA226_ReadSequence(INA226_Channel_t channel, const INAA226_DataType_t* data_types, uint8_t num, \
+                            INA226_SequenceCb_t complete_cb);
+uint16_t INA226_GetResult(INA226_Channel_t channel, INAA226_DataType_t data_type);
+uint8_t INA226_GetResults(INA226_Channel_t channel, INA226_Results_t* results);
 
 /*
  * Callbacks
  */
 void INA226_ReadCompleteCb(void);
 void INA226_WriteCompleteCb(void);
+void INA226_ErrorCb(void);
+void INA226_AbortCompleteCb(void);
 
 #endif  /* _INA226_H_ */
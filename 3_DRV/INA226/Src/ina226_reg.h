@@ -47,6 +47,34 @@
 #define INA226_POS_MASK_ENABLE_SUL      (0x0E)
 #define INA226_POS_MASK_ENABLE_SOL      (0x0F)
 
+/*
+ * Configuration Register (00h) field limits
+ */
+#define INA226_MAX_CONFIGURATION_MODE     (0x07)
+#define INA226_MAX_CONFIGURATION_VSHCT    (0x07)
+#define INA226_MAX_CONFIGURATION_VBUSCT   (0x07)
+#define INA226_MAX_CONFIGURATION_AVG      (0x07)
+#define INA226_MAX_CONFIGURATION_RST      (0x01)
+
+/*
+ * Configuration Register (00h) field values - conversion time in us and number of averages,
+ * indexed by the field value
+ */
+#define INA226_CONVERSION_TIME_US       {140U, 204U, 332U, 588U, 1100U, 2116U, 4156U, 8244U}
+#define INA226_AVERAGES                 {1U, 4U, 16U, 64U, 128U, 256U, 512U, 1024U}
+#define INA226_MODE_SHUNT               (0x01)  /* Operating Mode bit - shunt voltage is converted */
+#define INA226_MODE_BUS                 (0x02)  /* Operating Mode bit - bus voltage is converted */
+
+/*
+ * Fixed LSBs and calibration constants
+ */
+#define INA226_SHUNT_VOLTAGE_LSB_NV     (2500)                  /* nV */
+#define INA226_BUS_VOLTAGE_LSB_UV       (1250)                  /* uV */
+#define INA226_POWER_LSB_RATIO          (25ULL)                 /* Power LSB = 25 * Current LSB */
+#define INA226_CURRENT_LSB_DIVIDER      (32768ULL)              /* Current LSB = Max Expected Current / 2^15 */
+#define INA226_CALIBRATION_SCALE        (5120000000000ULL)      /* 0.00512 scaled for Current LSB in nA and shunt in uOhm */
+#define INA226_CALIBRATION_MAX          (0x7FFFULL)             /* Bit 15 is reserved */
+
 /***********************************************************************************************************
  *********************************************** Data types ************************************************
  ***********************************************************************************************************/
@@ -6,6 +6,10 @@
 #include "ina226.h"
 #include "hal_uart.h"
 #include "hal_gpio.h"
+#include "hal_energy_monitor.h"
+#include "hal_energy_monitor_cfg.h"
+#include "bench.h"
+#include "trace.h"
 
 /***********************************************************************************************************
  ************************************************* Defines *************************************************
@@ -40,11 +44,16 @@
  */
 void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
 {
+    TRACE_ISR_ENTER(Trace_I2cTxCplt);
+    BENCH_PROBE_BEGIN(Bench_I2cTxCplt);
+
     if(hi2c->Instance == I2C1)
     {
         INA226_WriteCompleteCb();
     }
-    
+
+    BENCH_PROBE_END(Bench_I2cTxCplt);
+    TRACE_ISR_EXIT(Trace_I2cTxCplt);
 }
 
 /*
@@ -52,27 +61,112 @@ void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
  */
 void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
 {
+    TRACE_ISR_ENTER(Trace_I2cRxCplt);
+    BENCH_PROBE_BEGIN(Bench_I2cRxCplt);
+
     if(hi2c->Instance == I2C1)
     {
         INA226_ReadCompleteCb();
     }
+
+    BENCH_PROBE_END(Bench_I2cRxCplt);
+    TRACE_ISR_EXIT(Trace_I2cRxCplt);
 }
 
 /*
- * GPIO interrupt callback - INA226 alert pin falling edge
+ * I2C error callback - INA226
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    TRACE_ISR_ENTER(Trace_I2cError);
+
+    if(hi2c->Instance == I2C1)
+    {
+        INA226_ErrorCb();
+    }
+
+    TRACE_ISR_EXIT(Trace_I2cError);
+}
+
+/*
+ * I2C abort complete callback - INA226 transfer stopped after a timeout
+ */
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    TRACE_ISR_ENTER(Trace_I2cAbortCplt);
+
+    if(hi2c->Instance == I2C1)
+    {
+        INA226_AbortCompleteCb();
+    }
+
+    TRACE_ISR_EXIT(Trace_I2cAbortCplt);
+}
+
+/*
+ * GPIO interrupt callback - INA226 alert pin falling edge. In conversion ready mode the pin
+ * signals new data, the alert function is then read from the Mask/Enable register.
  */
 void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
 {
+    TRACE_ISR_ENTER(Trace_GpioExti);
+    BENCH_PROBE_BEGIN(Bench_GpioExti);
+
     if(GPIO_Pin == GPIO_PIN_1)
     {
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+        Hal_EnergyMonitor_ConversionReadyCb();
+#else
         Hal_Gpio_AlertCb();
+#endif
     }
+
+    BENCH_PROBE_END(Bench_GpioExti);
+    TRACE_ISR_EXIT(Trace_GpioExti);
 }
 
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
+    TRACE_ISR_ENTER(Trace_UartTxCplt);
+    BENCH_PROBE_BEGIN(Bench_UartTxCplt);
+
     if(huart->Instance == USART3)
     {
         Hal_Uart_WriteCb();
     }
-}
\ No newline at end of file
+
+    BENCH_PROBE_END(Bench_UartTxCplt);
+    TRACE_ISR_EXIT(Trace_UartTxCplt);
+}
+
+/*
+ * UART reception event callback - idle line, half or full circular buffer
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    TRACE_ISR_ENTER(Trace_UartRxEvent);
+    BENCH_PROBE_BEGIN(Bench_UartRxEvent);
+
+    if(huart->Instance == USART3)
+    {
+        Hal_Uart_ReadCb(Size);
+    }
+
+    BENCH_PROBE_END(Bench_UartRxEvent);
+    TRACE_ISR_EXIT(Trace_UartRxEvent);
+}
+
+/*
+ * UART error callback
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    TRACE_ISR_ENTER(Trace_UartError);
+
+    if(huart->Instance == USART3)
+    {
+        Hal_Uart_ErrorCb();
+    }
+
+    TRACE_ISR_EXIT(Trace_UartError);
+}
@@ -0,0 +1,50 @@
+#ifndef _LOG_CFG_H_
+#define _LOG_CFG_H_
+
+/* 
+ * Log configuration file - all below defines should be filled by the user
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "dwt.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define LOG_QUEUE_LEN                   (64U)   /* Records - must be a power of 2 */
+
+/*!	
+ * \brief Get timestamp of the record
+ *
+ * \param[in] None
+ * 
+ * \retval Timestamp in CPU cycles
+ */
+#define Log_GetTimestamp()              (Dwt_GetCycles())
+
+/*!	
+ * \brief Convert the timestamp into ns
+ *
+ * \param[in] timestamp Timestamp in CPU cycles
+ * 
+ * \retval Timestamp in ns
+ */
+#define Log_TimestampToNs(timestamp)    (Dwt_CyclesToNs(timestamp))
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _LOG_CFG_H_ */
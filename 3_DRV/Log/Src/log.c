@@ -0,0 +1,203 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdatomic.h>
+#include "log.h"
+#include "log_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define LOG_QUEUE_MASK          (LOG_QUEUE_LEN - 1U)
+
+_Static_assert((LOG_QUEUE_LEN & LOG_QUEUE_MASK) == 0U, "LOG_QUEUE_LEN must be a power of 2");
+_Static_assert(LOG_ARGS_NUM == 3U, "Log_Write takes 3 arguments");
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Queue slot - the sequence tells who owns the slot: equal to the position when free for the producer,
+ * position + 1 when published for the consumer (bounded MPMC queue by D. Vyukov, single consumer here)
+ */
+typedef struct
+{
+    _Atomic uint32_t sequence;
+    uint16_t id;
+    int32_t args[LOG_ARGS_NUM];
+    uint64_t timestamp;                 /* Cycles */
+}Log_Slot_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static Log_Slot_t Log_Queue[LOG_QUEUE_LEN];
+static _Atomic uint32_t Log_WritePos;      /* Next position claimed by a producer */
+static uint32_t Log_ReadPos;               /* Consumer only */
+static _Atomic uint32_t Log_DroppedNum;    /* Records dropped because the queue was full */
+
+static const char* const Log_Text[Log_MessageMax] =
+{
+    #define LOG_MESSAGE(id, text)   [id] = text,
+        LOG_MESSAGE_TABLE
+    #undef LOG_MESSAGE
+};
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Log initialization function - should be called before any producer runs
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Log_Init(void)
+{
+    for(uint32_t i = 0; i < LOG_QUEUE_LEN; i++)
+    {
+        atomic_init(&Log_Queue[i].sequence, i);
+    }
+
+    atomic_init(&Log_WritePos, 0U);
+    atomic_init(&Log_DroppedNum, 0U);
+    Log_ReadPos = 0U;
+}
+
+/*!	
+ * \brief Push a record into the queue - may be called from any task or ISR. The slot is claimed
+ *        by a compare-and-swap of the write position, a failed swap means another producer (e.g.
+ *        a preempting ISR) took the slot, so the next one is tried. No waiting, no formatting.
+ *
+ * \param[in] id Message id
+ * \param[in] arg0 First argument
+ * \param[in] arg1 Second argument
+ * \param[in] arg2 Third argument
+ * 
+ * \retval true if queued, false if the queue is full and the record was dropped
+ */
+bool Log_Write(Log_MessageId_t id, int32_t arg0, int32_t arg1, int32_t arg2)
+{
+    uint64_t timestamp = Log_GetTimestamp();
+    uint32_t pos = atomic_load_explicit(&Log_WritePos, memory_order_relaxed);
+    Log_Slot_t* slot;
+    int32_t diff;
+    bool queued = false;
+    bool full = false;
+
+    while((!queued) && (!full))
+    {
+        slot = &Log_Queue[pos & LOG_QUEUE_MASK];
+        diff = (int32_t)(atomic_load_explicit(&slot->sequence, memory_order_acquire) - pos);
+
+        if(diff == 0)
+        {
+            /* Slot free - on failure pos is reloaded with the current write position */
+            queued = atomic_compare_exchange_weak_explicit(&Log_WritePos, &pos, pos + 1U, \
+                                                           memory_order_relaxed, memory_order_relaxed);
+        }
+        else if(diff < 0)
+        {
+            full = true;    /* Slot not consumed yet */
+        }
+        else
+        {
+            pos = atomic_load_explicit(&Log_WritePos, memory_order_relaxed);
+        }
+    }
+
+    if(queued)
+    {
+        slot->id = (uint16_t)id;
+        slot->args[0] = arg0;
+        slot->args[1] = arg1;
+        slot->args[2] = arg2;
+        slot->timestamp = timestamp;
+        atomic_store_explicit(&slot->sequence, pos + 1U, memory_order_release);
+    }
+    else
+    {
+        (void)atomic_fetch_add_explicit(&Log_DroppedNum, 1U, memory_order_relaxed);
+    }
+
+    return queued;
+}
+
+/*!	
+ * \brief Pop the oldest record - single consumer only. Records are read in the order the slots were
+ *        claimed, a claimed but not yet published slot stops the reading until the producer completes it.
+ *
+ * \param[out] record Record with the timestamp converted into ns
+ * 
+ * \retval true if a record was read
+ */
+bool Log_Read(Log_Record_t* record)
+{
+    Log_Slot_t* slot = &Log_Queue[Log_ReadPos & LOG_QUEUE_MASK];
+    bool ret_val = false;
+
+    if(atomic_load_explicit(&slot->sequence, memory_order_acquire) == (Log_ReadPos + 1U))
+    {
+        record->id = (Log_MessageId_t)slot->id;
+        record->args[0] = slot->args[0];
+        record->args[1] = slot->args[1];
+        record->args[2] = slot->args[2];
+        record->timestamp = Log_TimestampToNs(slot->timestamp);
+
+        /* Free the slot for the producers of the next lap */
+        atomic_store_explicit(&slot->sequence, Log_ReadPos + LOG_QUEUE_LEN, memory_order_release);
+        Log_ReadPos++;
+        ret_val = true;
+    }
+
+    return ret_val;
+}
+
+/*!	
+ * \brief Get number of records dropped because the queue was full
+ *
+ * \param[in] None
+ * 
+ * \retval Dropped records since start-up
+ */
+uint32_t Log_GetDropped(void)
+{
+    return atomic_load_explicit(&Log_DroppedNum, memory_order_relaxed);
+}
+
+/*!	
+ * \brief Get text of the message
+ *
+ * \param[in] id Message id
+ * 
+ * \retval Message text, empty for an invalid id
+ */
+const char* Log_GetText(Log_MessageId_t id)
+{
+    const char* text = "";
+
+    if(id < Log_MessageMax)
+    {
+        text = Log_Text[id];
+    }
+
+    return text;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
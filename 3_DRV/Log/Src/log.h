@@ -0,0 +1,82 @@
+#ifndef _LOG_H_
+#define _LOG_H_
+
+/* 
+ * Deferred binary log - any task or ISR pushes a record (message id, arguments and timestamp) into
+ * a lock-free multi-producer queue, one low priority consumer formats and transmits the records.
+ * Producers never wait for each other or for the consumer, a record which does not fit is dropped
+ * and counted.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Configuration
+ */
+
+#define LOG_ARGS_NUM            (3U)    /* Arguments of one record - unused arguments are 0 */
+
+/*
+ * Log messages: id, text. The text is formatted by the consumer - %d is replaced by the next argument
+ * as a signed number, %u as an unsigned number.
+ */
+#define LOG_MESSAGE_TABLE  \
+    LOG_MESSAGE(Log_Startup,            "Energy monitor started, %u channels")              \
+    LOG_MESSAGE(Log_Dropped,            "Log queue full, %u records dropped")               \
+    LOG_MESSAGE(Log_I2cError,           "I2C error, device address %u, bus status %u")      \
+    LOG_MESSAGE(Log_SequenceTimeout,    "CH%u read sequence timed out")                     \
+    LOG_MESSAGE(Log_UartDropped,        "UART buffer full, %u bytes dropped")                \
+    LOG_MESSAGE(Log_CommandRejected,    "Command rejected")                                 \
+    LOG_MESSAGE(Log_PeriodSet,          "Acquisition period %u us")                         \
+    LOG_MESSAGE(Log_FormatSet,          "Log format %u")                                    \
+    LOG_MESSAGE(Log_HistoryDumped,      "History dumped, %u samples")                       \
+    LOG_MESSAGE(Log_TraceDumped,        "Trace dumped, %u events, %u lost")                 \
+    LOG_MESSAGE(Log_EnergyReset,        "Energy and charge reset")
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    #define LOG_MESSAGE(id, text)   id,
+        LOG_MESSAGE_TABLE
+    #undef LOG_MESSAGE
+    Log_MessageMax
+}Log_MessageId_t;
+
+/* One record as read by the consumer */
+typedef struct
+{
+    uint64_t timestamp;                 /* ns */
+    int32_t args[LOG_ARGS_NUM];
+    Log_MessageId_t id;
+}Log_Record_t;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Log_Init(void);
+bool Log_Write(Log_MessageId_t id, int32_t arg0, int32_t arg1, int32_t arg2);
+bool Log_Read(Log_Record_t* record);
+uint32_t Log_GetDropped(void);
+const char* Log_GetText(Log_MessageId_t id);
+
+#endif  /* _LOG_H_ */
@@ -0,0 +1,87 @@
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+/* 
+ * Lock-free double-buffered snapshot - one writer publishes complete data sets, any number of readers
+ * get a coherent copy without disabling interrupts or taking a mutex. The writer fills the inactive
+ * buffer and publishes it by incrementing the sequence. Readers never wait for the writer (a reader
+ * may preempt it, e.g. a higher priority task), they only retry when the writer published
+ * during the copy.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include "stm32f7xx.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Snapshot type of the data type
+ *
+ * \param[in] data_type Type of one data set
+ */
+#define SNAPSHOT_TYPE(data_type)                struct { volatile uint32_t sequence; data_type buf[2]; }
+
+/*!	
+ * \brief Get buffer for the next data set - writer only
+ *
+ * \param[in] snap Snapshot pointer
+ * 
+ * \retval Pointer to the inactive buffer
+ */
+#define Snapshot_WriteBuf(snap)                 (&(snap)->buf[((snap)->sequence + 1U) & 1U])
+
+/*!	
+ * \brief Get last published data set - writer only, readers use Snapshot_Read
+ *
+ * \param[in] snap Snapshot pointer
+ * 
+ * \retval Pointer to the active buffer
+ */
+#define Snapshot_ReadBuf(snap)                  (&(snap)->buf[(snap)->sequence & 1U])
+
+/*!	
+ * \brief Publish the data set written to Snapshot_WriteBuf - writer only
+ *
+ * \param[in] snap Snapshot pointer
+ * 
+ * \retval None
+ */
+#define Snapshot_Publish(snap)                  do { __DMB(); (snap)->sequence++; } while(0)
+
+/*!	
+ * \brief Copy last published data set
+ *
+ * \param[in] snap Snapshot pointer
+ * \param[out] data_ptr Pointer to store the data set
+ * 
+ * \retval None
+ */
+#define Snapshot_Read(snap, data_ptr)           do { \
+                                                    uint32_t snapshot_seq; \
+                                                    do { \
+                                                        snapshot_seq = (snap)->sequence; \
+                                                        __DMB(); \
+                                                        *(data_ptr) = (snap)->buf[snapshot_seq & 1U]; \
+                                                        __DMB(); \
+                                                    } while(snapshot_seq != (snap)->sequence); \
+                                                } while(0)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _SNAPSHOT_H_ */
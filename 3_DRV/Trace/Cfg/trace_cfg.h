@@ -0,0 +1,67 @@
+#ifndef _TRACE_CFG_H_
+#define _TRACE_CFG_H_
+
+/* 
+ * Trace recorder configuration file - all below defines should be filled by the user
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "dwt.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE                    (1U)    /* 0 - the trace hooks compile to nothing */
+#endif
+
+#define TRACE_BUFFER_LEN                (2048U) /* Events kept, 8 bytes each - must be a power of 2 */
+
+/*
+ * Interrupt sources: id, name. Handlers of stm32f7xx_it.c and the HAL callbacks of irq.c, a callback
+ * runs inside its handler. Ids must fit in 8 bits.
+ */
+#define TRACE_CFG_ISR_TABLE  \
+    TRACE_CFG_ISR(Trace_Exti1,              "EXTI1")                \
+    TRACE_CFG_ISR(Trace_Dma1Stream0,        "DMA1_Stream0")         \
+    TRACE_CFG_ISR(Trace_Dma1Stream1,        "DMA1_Stream1")         \
+    TRACE_CFG_ISR(Trace_Dma1Stream3,        "DMA1_Stream3")         \
+    TRACE_CFG_ISR(Trace_Dma1Stream6,        "DMA1_Stream6")         \
+    TRACE_CFG_ISR(Trace_I2c1Ev,             "I2C1_EV")              \
+    TRACE_CFG_ISR(Trace_I2c1Er,             "I2C1_ER")              \
+    TRACE_CFG_ISR(Trace_Usart3,             "USART3")               \
+    TRACE_CFG_ISR(Trace_I2cTxCplt,          "i2c_tx_cplt")          \
+    TRACE_CFG_ISR(Trace_I2cRxCplt,          "i2c_rx_cplt")          \
+    TRACE_CFG_ISR(Trace_I2cError,           "i2c_error")            \
+    TRACE_CFG_ISR(Trace_I2cAbortCplt,       "i2c_abort_cplt")       \
+    TRACE_CFG_ISR(Trace_GpioExti,           "gpio_exti")            \
+    TRACE_CFG_ISR(Trace_UartTxCplt,         "uart_tx_cplt")         \
+    TRACE_CFG_ISR(Trace_UartRxEvent,        "uart_rx_event")        \
+    TRACE_CFG_ISR(Trace_UartError,          "uart_error")
+
+/*!	
+ * \brief Get timestamp of the event
+ *
+ * \param[in] None
+ * 
+ * \retval Timestamp in CPU cycles - the lower 32 bits are recorded
+ */
+#define Trace_GetTimestamp()            (Dwt_GetCycles())
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _TRACE_CFG_H_ */
@@ -0,0 +1,209 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "trace.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define TRACE_BUFFER_MASK       (TRACE_BUFFER_LEN - 1U)
+
+_Static_assert((TRACE_BUFFER_LEN & TRACE_BUFFER_MASK) == 0U, "TRACE_BUFFER_LEN must be a power of 2");
+_Static_assert(TRACE_BUFFER_LEN < 0x10000U, "Slot index is 16 bits");
+_Static_assert(Trace_IsrMax <= 0x100U, "Interrupt id is 8 bits");
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Buffer slot - the index (lower 16 bits of the write position) is stored last, so a slot which is
+ * claimed but not written yet, or overwritten during the read, is recognized and skipped
+ */
+typedef struct
+{
+    uint32_t timestamp;
+    uint8_t event;
+    uint8_t id;
+    _Atomic uint16_t index;
+}Trace_Slot_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static Trace_Slot_t Trace_Buffer[TRACE_BUFFER_LEN];
+static _Atomic uint32_t Trace_WritePos;     /* Next position claimed by a writer, events since start-up */
+static atomic_bool Trace_Running;
+
+static const char* const Trace_IsrName[Trace_IsrMax] =
+{
+    #define TRACE_CFG_ISR(id, name)     [id] = name,
+        TRACE_CFG_ISR_TABLE
+    #undef TRACE_CFG_ISR
+};
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!	
+ * \brief Trace initialization function - should be called before the scheduler and the interrupts
+ *        start, the recording is running after the call
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Trace_Init(void)
+{
+    for(uint32_t i = 0; i < TRACE_BUFFER_LEN; i++)
+    {
+        /* Index of the previous lap - no slot is valid before it is written */
+        atomic_init(&Trace_Buffer[i].index, (uint16_t)(i - TRACE_BUFFER_LEN));
+    }
+
+    atomic_init(&Trace_WritePos, 0U);
+    atomic_init(&Trace_Running, true);
+}
+
+/*!	
+ * \brief Record an event - may be called from any task or ISR, a few tens of cycles. A preempting
+ *        writer takes the next slot, so the events are ordered by the timestamp on the host.
+ *
+ * \param[in] event Event type
+ * \param[in] id Task number or interrupt id
+ * 
+ * \retval None
+ */
+void Trace_Record(Trace_Event_t event, uint32_t id)
+{
+    uint32_t pos;
+    Trace_Slot_t* slot;
+
+    if(atomic_load_explicit(&Trace_Running, memory_order_relaxed))
+    {
+        pos = atomic_fetch_add_explicit(&Trace_WritePos, 1U, memory_order_relaxed);
+        slot = &Trace_Buffer[pos & TRACE_BUFFER_MASK];
+
+        slot->timestamp = (uint32_t)Trace_GetTimestamp();
+        slot->event = (uint8_t)event;
+        slot->id = (uint8_t)id;
+        atomic_store_explicit(&slot->index, (uint16_t)pos, memory_order_release);
+    }
+}
+
+/*!	
+ * \brief Resume the recording
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Trace_Start(void)
+{
+    atomic_store_explicit(&Trace_Running, true, memory_order_relaxed);
+}
+
+/*!	
+ * \brief Pause the recording - the buffer keeps the events before the call and can be read
+ *
+ * \param[in] None
+ * 
+ * \retval None
+ */
+void Trace_Stop(void)
+{
+    atomic_store_explicit(&Trace_Running, false, memory_order_relaxed);
+}
+
+/*!	
+ * \brief Read recorded events, oldest first - the recording should be paused. The reader keeps its
+ *        cursor (0 reads from the oldest event kept), slots not written completely are skipped.
+ *
+ * \param[out] batch Buffer for the events
+ * \param[in] size Size of the buffer in events
+ * \param[in,out] cursor Reader position, updated by the call
+ * 
+ * \retval Number of events stored in batch, 0 when all events were read
+ */
+uint32_t Trace_ReadBatch(Trace_Record_t* batch, uint32_t size, uint32_t* cursor)
+{
+    uint32_t head = atomic_load_explicit(&Trace_WritePos, memory_order_relaxed);
+    uint32_t pos = *cursor;
+    uint32_t num = 0U;
+    const Trace_Slot_t* slot;
+
+    /* Oldest events already overwritten */
+    if((head - pos) > TRACE_BUFFER_LEN)
+    {
+        pos = head - TRACE_BUFFER_LEN;
+    }
+
+    while((num < size) && (pos != head))
+    {
+        slot = &Trace_Buffer[pos & TRACE_BUFFER_MASK];
+
+        if(atomic_load_explicit(&slot->index, memory_order_acquire) == (uint16_t)pos)
+        {
+            batch[num].timestamp = slot->timestamp;
+            batch[num].event = slot->event;
+            batch[num].id = slot->id;
+            num++;
+        }
+
+        pos++;
+    }
+
+    *cursor = pos;
+
+    return num;
+}
+
+/*!	
+ * \brief Get number of events recorded since start-up - the ones before the last TRACE_BUFFER_LEN
+ *        are overwritten
+ *
+ * \param[in] None
+ * 
+ * \retval Number of events
+ */
+uint32_t Trace_GetWritten(void)
+{
+    return atomic_load_explicit(&Trace_WritePos, memory_order_relaxed);
+}
+
+/*!	
+ * \brief Get name of the interrupt source
+ *
+ * \param[in] id Interrupt id
+ * 
+ * \retval Name, empty for an invalid id
+ */
+const char* Trace_GetIsrName(uint32_t id)
+{
+    const char* name = "";
+
+    if(id < Trace_IsrMax)
+    {
+        name = Trace_IsrName[id];
+    }
+
+    return name;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
@@ -0,0 +1,110 @@
+#ifndef _TRACE_H_
+#define _TRACE_H_
+
+/* 
+ * Trace recorder - context switches (FreeRTOS traceTASK_SWITCHED_IN/OUT, see FreeRTOSConfig.h) and
+ * interrupt handler entries and exits with the cycle counter timestamp, written into a RAM ring
+ * buffer which keeps the last TRACE_BUFFER_LEN events. Writers never wait or lock: any task or ISR
+ * claims a slot with one atomic increment. The buffer is read after Trace_Stop, e.g. by the "trace"
+ * command, and converted on the host by Tools/trace_to_perfetto.py.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include "trace_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#if (TRACE_ENABLE == 1U)
+
+/*!	
+ * \brief Task switched in - called by the kernel with interrupts up to the syscall priority masked
+ *
+ * \param[in] task FreeRTOS task number
+ */
+#define TRACE_TASK_SWITCHED_IN(task)    Trace_Record(Trace_EventTaskIn, (uint32_t)(task))
+
+/*!	
+ * \brief Task switched out
+ *
+ * \param[in] task FreeRTOS task number
+ */
+#define TRACE_TASK_SWITCHED_OUT(task)   Trace_Record(Trace_EventTaskOut, (uint32_t)(task))
+
+/*!	
+ * \brief Interrupt handler or callback entry
+ *
+ * \param[in] id Id from TRACE_CFG_ISR_TABLE
+ */
+#define TRACE_ISR_ENTER(id)             Trace_Record(Trace_EventIsrEnter, (uint32_t)(id))
+
+/*!	
+ * \brief Interrupt handler or callback exit
+ *
+ * \param[in] id Id from TRACE_CFG_ISR_TABLE
+ */
+#define TRACE_ISR_EXIT(id)              Trace_Record(Trace_EventIsrExit, (uint32_t)(id))
+
+#else
+
+#define TRACE_TASK_SWITCHED_IN(task)    ((void)0)
+#define TRACE_TASK_SWITCHED_OUT(task)   ((void)0)
+#define TRACE_ISR_ENTER(id)             ((void)0)
+#define TRACE_ISR_EXIT(id)              ((void)0)
+
+#endif
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    Trace_EventTaskIn = 0,
+    Trace_EventTaskOut,
+    Trace_EventIsrEnter,
+    Trace_EventIsrExit,
+    Trace_EventMax
+}Trace_Event_t;
+
+typedef enum
+{
+    #define TRACE_CFG_ISR(id, name)     id,
+        TRACE_CFG_ISR_TABLE
+    #undef TRACE_CFG_ISR
+    Trace_IsrMax
+}Trace_IsrId_t;
+
+/* One event as read from the buffer */
+typedef struct
+{
+    uint32_t timestamp;         /* Lower 32 bits of the cycle counter - wraps every ~19.9 s */
+    uint8_t event;              /* Trace_Event_t */
+    uint8_t id;                 /* Task number or Trace_IsrId_t */
+}Trace_Record_t;
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Trace_Init(void);
+void Trace_Record(Trace_Event_t event, uint32_t id);
+void Trace_Start(void);
+void Trace_Stop(void);
+uint32_t Trace_ReadBatch(Trace_Record_t* batch, uint32_t size, uint32_t* cursor);
+uint32_t Trace_GetWritten(void);
+const char* Trace_GetIsrName(uint32_t id);
+
+#endif  /* _TRACE_H_ */
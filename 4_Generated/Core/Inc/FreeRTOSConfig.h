@@ -52,6 +52,8 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
   void xPortSysTickHandler(void);
+  void configureTimerForRunTimeStats(void);
+  unsigned long getRunTimeCounterValue(void);
 #endif
 #define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
@@ -71,6 +73,8 @@
 #define configUSE_MUTEXES                        1
 #define configQUEUE_REGISTRY_SIZE                8
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
 /* USER CODE BEGIN MESSAGE_BUFFER_LENGTH_TYPE */
 /* Defaults to size_t for backward compatibility, but can be changed
    if lengths will always be less than the number of bytes in a size_t. */
@@ -133,8 +137,20 @@ standard names. */
 
 /* #define xPortSysTickHandler SysTick_Handler */
 
+/* USER CODE BEGIN 2 */
+/* Definitions needed when configGENERATE_RUN_TIME_STATS is on */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE getRunTimeCounterValue
+/* USER CODE END 2 */
+
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Trace recorder (3_DRV/Trace) - task numbers are kept with configUSE_TRACE_FACILITY */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+  #include "trace.h"
+  #define traceTASK_SWITCHED_IN()     TRACE_TASK_SWITCHED_IN(pxCurrentTCB->uxTCBNumber)
+  #define traceTASK_SWITCHED_OUT()    TRACE_TASK_SWITCHED_OUT(pxCurrentTCB->uxTCBNumber)
+#endif
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
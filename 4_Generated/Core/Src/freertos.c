@@ -25,6 +25,7 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "dwt.h"
 
 /* USER CODE END Includes */
 
@@ -35,6 +36,8 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
+/* Run time stats clock - 216 MHz / 2^6 = 3.375 MHz, the 32-bit task counters wrap after ~21 min */
+#define RUN_TIME_STATS_SHIFT    (6U)
 
 /* USER CODE END PD */
 
@@ -58,6 +61,24 @@ void StartDefaultTask(void const * argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+void configureTimerForRunTimeStats(void)
+{
+  /* DWT cycle counter runs since Dwt_Init in main() */
+}
+
+unsigned long getRunTimeCounterValue(void)
+{
+  /* Called on every context switch - a few cycles, no division */
+  return (unsigned long)(Dwt_GetCycles() >> RUN_TIME_STATS_SHIFT);
+}
+/* USER CODE END 1 */
+
 /* GetIdleTaskMemory prototype (linked to static allocation support) */
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
@@ -0,0 +1,61 @@
+#ifndef _SIM_CFG_H_
+#define _SIM_CFG_H_
+
+/*
+ * Host simulation configuration file - all below defines should be filled by the user
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Core
+ */
+#define SIM_CORE_CLOCK_HZ                   (216000000U)    /* SystemCoreClock of the target - scales the simulated DWT */
+
+/*
+ * I2C1 - transfer time is (address + data bytes) * (8 bits + ACK) at the bit rate
+ */
+#define SIM_I2C_BIT_RATE_HZ                 (400000U)       /* Fast mode (Timing 0x2010091A) */
+#define SIM_I2C_BYTE_BITS                   (9U)
+#define SIM_I2C_NVIC_PRIORITY               (6U)            /* I2C1 event/error and DMA1 Stream0/6 */
+
+/*
+ * USART3 - 8N1, the transmitted stream goes to stdout, stdin is received
+ */
+#define SIM_UART_BAUD_RATE                  (115200U)
+#define SIM_UART_FRAME_BITS                 (10U)
+#define SIM_UART_NVIC_PRIORITY              (7U)            /* USART3 and DMA1 Stream1/3 */
+
+/*
+ * Simulated INA226 devices on I2C1: 7-bit address, constant bus voltage in uV and load current in uA
+ * unless a waveform is loaded (-w option of the simulation). The devices
+ * share the ALERT line (open drain, INA226_ALERT_Pin). Remove a device to exercise the I2C error path.
+ * The multi-device build provides its own table (sim_multi_cfg.h).
+ */
+#ifndef SIM_INA226_CFG_TABLE
+#define SIM_INA226_CFG_TABLE  \
+    SIM_INA226_CFG_DEVICE(0x40, 3300000, 20000)
+#endif
+
+#define SIM_INA226_SHUNT_RESISTANCE_UOHM    (100000LL)      /* Shunt on the board - 0.1 Ohm */
+#define SIM_INA226_NVIC_PRIORITY            (8U)            /* EXTI1 - ALERT line */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _SIM_CFG_H_ */
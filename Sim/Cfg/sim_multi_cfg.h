@@ -0,0 +1,74 @@
+#ifndef _SIM_MULTI_CFG_H_
+#define _SIM_MULTI_CFG_H_
+
+/*
+ * Multi-device host simulation - all 16 INA226 addresses (0x40 - 0x4F) on one I2C bus. Included before
+ * every source file of the energy_monitor_sim_multi target, so the tables replace the default ones of
+ * ina226_cfg.h and sim_cfg.h. The report gives the aggregate throughput of the bus.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Firmware devices: name, I2C address, calibration, mask/enable, alert limit
+ */
+#define INA226_CFG_DEVICE_TABLE  \
+    INA226_CFG_DEVICE(INA226_Channel0,  0x40, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel1,  0x41, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel2,  0x42, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel3,  0x43, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel4,  0x44, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel5,  0x45, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel6,  0x46, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel7,  0x47, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel8,  0x48, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel9,  0x49, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel10, 0x4A, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel11, 0x4B, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel12, 0x4C, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel13, 0x4D, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel14, 0x4E, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)   \
+    INA226_CFG_DEVICE(INA226_Channel15, 0x4F, INA226_CFG_CALIBRATION, INA226_CFG_MASK_ENABLE, INA226_CFG_ALERT_LIMIT)
+
+/*
+ * Simulated devices: 7-bit address, bus voltage in uV, load current in uA. Loads stay below the power
+ * alert limit - an asserted alert function holds the shared ALERT line low, then the sweeps only run
+ * on the conversion ready timeout.
+ */
+#define SIM_INA226_CFG_TABLE  \
+    SIM_INA226_CFG_DEVICE(0x40, 3300000, 20000)     \
+    SIM_INA226_CFG_DEVICE(0x41, 3300000, 12000)     \
+    SIM_INA226_CFG_DEVICE(0x42, 5000000, 15000)     \
+    SIM_INA226_CFG_DEVICE(0x43, 5000000,  8000)     \
+    SIM_INA226_CFG_DEVICE(0x44, 1800000,  5000)     \
+    SIM_INA226_CFG_DEVICE(0x45, 1800000, 40000)     \
+    SIM_INA226_CFG_DEVICE(0x46, 1200000, 60000)     \
+    SIM_INA226_CFG_DEVICE(0x47, 1200000, 31000)     \
+    SIM_INA226_CFG_DEVICE(0x48, 3300000,  1000)     \
+    SIM_INA226_CFG_DEVICE(0x49, 3300000, 23000)     \
+    SIM_INA226_CFG_DEVICE(0x4A, 5000000,  2500)     \
+    SIM_INA226_CFG_DEVICE(0x4B, 5000000, 10000)     \
+    SIM_INA226_CFG_DEVICE(0x4C, 2500000, 30000)     \
+    SIM_INA226_CFG_DEVICE(0x4D, 2500000, 18000)     \
+    SIM_INA226_CFG_DEVICE(0x4E, 2500000,  9000)     \
+    SIM_INA226_CFG_DEVICE(0x4F, 2500000,  7000)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _SIM_MULTI_CFG_H_ */
@@ -0,0 +1,187 @@
+#ifndef _CMSIS_OS_H_
+#define _CMSIS_OS_H_
+
+/*
+ * Host stand-in of the CMSIS-RTOS v1 API - the subset used by the DRV, HAL and APP layers, implemented
+ * over POSIX threads (sim_os.c). Priorities map to SCHED_FIFO when the process may use it, otherwise
+ * the threads run concurrently on the host cores. Critical sections take one recursive lock which is
+ * held by the simulated peripherals while they run the interrupt callbacks, so a task in a critical
+ * section is never "interrupted".
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define osWaitForever               (0xFFFFFFFFU)   /* Wait forever timeout value */
+#define osKernelSysTickFrequency    (1000U)         /* Tick rate - same as configTICK_RATE_HZ */
+
+/*!
+ * \brief Define the attributes of a thread function
+ *
+ * \param[in] name Name of the thread function
+ * \param[in] thread Thread function
+ * \param[in] priority Initial priority
+ * \param[in] instances Number of instances
+ * \param[in] stacksz Stack size requirements - the host default stack is used
+ */
+#define osThreadDef(name, thread, priority, instances, stacksz)  \
+    const osThreadDef_t os_thread_def_##name = { #name, (thread), (priority), (instances), (stacksz) }
+
+/*!
+ * \brief Access a thread definition
+ *
+ * \param[in] name Name of the thread definition
+ */
+#define osThread(name)              (&os_thread_def_##name)
+
+/*!
+ * \brief Define a semaphore object
+ *
+ * \param[in] name Name of the semaphore object
+ */
+#define osSemaphoreDef(name)        const osSemaphoreDef_t os_semaphore_def_##name = { 0 }
+
+/*!
+ * \brief Access a semaphore definition
+ *
+ * \param[in] name Name of the semaphore object
+ */
+#define osSemaphore(name)           (&os_semaphore_def_##name)
+
+/*
+ * FreeRTOS critical section
+ */
+#define taskENTER_CRITICAL()        (Sim_Os_EnterCritical())
+#define taskEXIT_CRITICAL()         (Sim_Os_ExitCritical())
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    osPriorityIdle          = -3,
+    osPriorityLow           = -2,
+    osPriorityBelowNormal   = -1,
+    osPriorityNormal        =  0,
+    osPriorityAboveNormal   = +1,
+    osPriorityHigh          = +2,
+    osPriorityRealtime      = +3,
+    osPriorityError         =  0x84
+}osPriority;
+
+typedef enum
+{
+    osOK                    = 0x00,
+    osEventSignal           = 0x08,
+    osEventMessage          = 0x10,
+    osEventMail             = 0x20,
+    osEventTimeout          = 0x40,
+    osErrorParameter        = 0x80,
+    osErrorResource         = 0x81,
+    osErrorTimeoutResource  = 0xC1,
+    osErrorISR              = 0x82,
+    osErrorValue            = 0x86,
+    osErrorOS               = 0xFF
+}osStatus;
+
+typedef void (*os_pthread)(void const* argument);
+
+typedef struct os_thread_cb* osThreadId;
+typedef struct os_semaphore_cb* osSemaphoreId;
+
+typedef struct os_thread_def
+{
+    char* name;
+    os_pthread pthread;
+    osPriority tpriority;
+    uint32_t instances;
+    uint32_t stacksize;
+}osThreadDef_t;
+
+/*
+ * FreeRTOS task state - the members filled by uxTaskGetSystemState
+ */
+typedef void* TaskHandle_t;
+typedef unsigned long UBaseType_t;
+
+typedef struct xTASK_STATUS
+{
+    TaskHandle_t xHandle;
+    const char* pcTaskName;
+    UBaseType_t xTaskNumber;
+    UBaseType_t uxCurrentPriority;
+    uint32_t ulRunTimeCounter;
+    uint16_t usStackHighWaterMark;
+}TaskStatus_t;
+
+typedef struct os_semaphore_def
+{
+    uint32_t dummy;
+}osSemaphoreDef_t;
+
+typedef struct
+{
+    osStatus status;
+    union
+    {
+        uint32_t v;
+        void* p;
+        int32_t signals;
+    }value;
+}osEvent;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * Kernel
+ */
+osStatus osKernelStart(void);
+uint32_t osKernelSysTick(void);
+
+/*
+ * Threads
+ */
+osThreadId osThreadCreate(const osThreadDef_t* thread_def, void* argument);
+osStatus osDelay(uint32_t millisec);
+osStatus osDelayUntil(uint32_t* PreviousWakeTime, uint32_t millisec);
+
+/*
+ * Signals
+ */
+int32_t osSignalSet(osThreadId thread_id, int32_t signals);
+osEvent osSignalWait(int32_t signals, uint32_t millisec);
+
+/*
+ * Semaphores
+ */
+osSemaphoreId osSemaphoreCreate(const osSemaphoreDef_t* semaphore_def, int32_t count);
+int32_t osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec);
+osStatus osSemaphoreRelease(osSemaphoreId semaphore_id);
+
+/*
+ * FreeRTOS task statistics - configUSE_TRACE_FACILITY and configGENERATE_RUN_TIME_STATS
+ */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t* const pulTotalRunTime);
+
+/*
+ * Critical section
+ */
+void Sim_Os_EnterCritical(void);
+void Sim_Os_ExitCritical(void);
+
+#endif  /* _CMSIS_OS_H_ */
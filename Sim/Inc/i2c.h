@@ -0,0 +1,32 @@
+#ifndef _I2C_H_
+#define _I2C_H_
+
+/*
+ * Host stand-in of the generated i2c.h - the handle is owned by the simulated I2C bus (sim_i2c.c)
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "main.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+extern I2C_HandleTypeDef hi2c1;
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _I2C_H_ */
@@ -0,0 +1,39 @@
+#ifndef _MAIN_H_
+#define _MAIN_H_
+
+/*
+ * Host stand-in of main.h - board pins of the NUCLEO-F767ZI used by the simulation
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "stm32f7xx_hal.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define LD1_Pin                     GPIO_PIN_0
+#define LD1_GPIO_Port               GPIOB
+#define INA226_ALERT_Pin            GPIO_PIN_1
+#define INA226_ALERT_GPIO_Port      GPIOG
+#define LD3_Pin                     GPIO_PIN_14
+#define LD3_GPIO_Port               GPIOB
+#define LD2_Pin                     GPIO_PIN_7
+#define LD2_GPIO_Port               GPIOB
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _MAIN_H_ */
@@ -0,0 +1,42 @@
+#ifndef _STM32F7XX_H_
+#define _STM32F7XX_H_
+
+/*
+ * Host stand-in of the CMSIS device header - core intrinsics used by the DRV, HAL and APP layers
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Data memory barrier - full fence, the host threads run on several cores
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+#define __DMB()                     (atomic_thread_fence(memory_order_seq_cst))
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+extern uint32_t SystemCoreClock;
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+#endif  /* _STM32F7XX_H_ */
@@ -0,0 +1,165 @@
+#ifndef _STM32F7XX_HAL_H_
+#define _STM32F7XX_HAL_H_
+
+/*
+ * Host stand-in of the STM32F7 HAL - handles, instances and functions used by the DRV, HAL and APP
+ * layers. The functions are implemented by the simulated peripherals (sim_i2c.c, sim_uart.c,
+ * sim_gpio.c), which complete the transfers from their own threads and call the HAL callbacks (irq.c).
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include "stm32f7xx.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Peripheral instances
+ */
+#define I2C1                        (&Sim_I2c1)
+#define USART3                      (&Sim_Usart3)
+#define GPIOA                       (&Sim_Gpio[0])
+#define GPIOB                       (&Sim_Gpio[1])
+#define GPIOC                       (&Sim_Gpio[2])
+#define GPIOD                       (&Sim_Gpio[3])
+#define GPIOE                       (&Sim_Gpio[4])
+#define GPIOF                       (&Sim_Gpio[5])
+#define GPIOG                       (&Sim_Gpio[6])
+#define GPIOH                       (&Sim_Gpio[7])
+#define SIM_GPIO_PORTS_NUM          (8U)
+
+/*
+ * GPIO pins
+ */
+#define GPIO_PIN_0                  ((uint16_t)0x0001U)
+#define GPIO_PIN_1                  ((uint16_t)0x0002U)
+#define GPIO_PIN_2                  ((uint16_t)0x0004U)
+#define GPIO_PIN_3                  ((uint16_t)0x0008U)
+#define GPIO_PIN_4                  ((uint16_t)0x0010U)
+#define GPIO_PIN_5                  ((uint16_t)0x0020U)
+#define GPIO_PIN_6                  ((uint16_t)0x0040U)
+#define GPIO_PIN_7                  ((uint16_t)0x0080U)
+#define GPIO_PIN_8                  ((uint16_t)0x0100U)
+#define GPIO_PIN_9                  ((uint16_t)0x0200U)
+#define GPIO_PIN_10                 ((uint16_t)0x0400U)
+#define GPIO_PIN_11                 ((uint16_t)0x0800U)
+#define GPIO_PIN_12                 ((uint16_t)0x1000U)
+#define GPIO_PIN_13                 ((uint16_t)0x2000U)
+#define GPIO_PIN_14                 ((uint16_t)0x4000U)
+#define GPIO_PIN_15                 ((uint16_t)0x8000U)
+
+/*
+ * Error codes
+ */
+#define HAL_I2C_ERROR_NONE          (0x00000000U)
+#define HAL_I2C_ERROR_AF            (0x00000004U)   /* Acknowledge failure */
+#define HAL_UART_ERROR_NONE         (0x00000000U)
+#define HAL_UART_ERROR_ORE          (0x00000008U)   /* Overrun error */
+
+/*
+ * UART states
+ */
+#define HAL_UART_STATE_READY        (0x00000020U)   /* No transfer runs */
+#define HAL_UART_STATE_BUSY_TX      (0x00000021U)   /* Transmission runs */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+}HAL_StatusTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+}GPIO_PinState;
+
+typedef struct
+{
+    uint32_t id;
+}I2C_TypeDef;
+
+typedef struct
+{
+    uint32_t id;
+}USART_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t IDR;      /* Input pin levels */
+    volatile uint32_t ODR;      /* Output pin levels */
+}GPIO_TypeDef;
+
+typedef struct
+{
+    I2C_TypeDef* Instance;
+    volatile uint32_t ErrorCode;
+}I2C_HandleTypeDef;
+
+typedef uint32_t HAL_UART_StateTypeDef;
+
+typedef struct
+{
+    USART_TypeDef* Instance;
+    volatile HAL_UART_StateTypeDef gState;      /* Transmission state */
+    volatile uint32_t ErrorCode;
+}UART_HandleTypeDef;
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+extern I2C_TypeDef Sim_I2c1;
+extern USART_TypeDef Sim_Usart3;
+extern GPIO_TypeDef Sim_Gpio[SIM_GPIO_PORTS_NUM];
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * I2C
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                              uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size);
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef *hi2c);
+
+/*
+ * UART
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/*
+ * GPIO
+ */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+
+#endif  /* _STM32F7XX_HAL_H_ */
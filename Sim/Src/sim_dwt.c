@@ -0,0 +1,82 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "dwt.h"
+#include "stm32f7xx.h"
+#include "sim_os.h"
+#include "sim_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+uint32_t SystemCoreClock = SIM_CORE_CLOCK_HZ;
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulated DWT cycle counter initialization function - the counter runs from Sim_Os_Init
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Dwt_Init(void)
+{
+}
+
+/*!
+ * \brief Simulated wrap count update - the host counter is 64-bit, nothing to track
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Dwt_Update(void)
+{
+}
+
+/*!
+ * \brief Get simulated cycle counter - host monotonic time scaled to SystemCoreClock
+ *
+ * \param[in] None
+ *
+ * \retval Cycles since Sim_Os_Init
+ */
+uint64_t Dwt_GetCycles(void)
+{
+    uint64_t time = Sim_Os_GetTimeNs();
+
+    return ((time / SIM_OS_NS_IN_S) * SystemCoreClock) + (((time % SIM_OS_NS_IN_S) * SystemCoreClock) / SIM_OS_NS_IN_S);
+}
+
+/*!
+ * \brief Convert cycles into nanoseconds
+ *
+ * \param[in] cycles Cycles returned by Dwt_GetCycles
+ *
+ * \retval Time in ns
+ */
+uint64_t Dwt_CyclesToNs(uint64_t cycles)
+{
+    return ((cycles / SystemCoreClock) * SIM_OS_NS_IN_S) + (((cycles % SystemCoreClock) * SIM_OS_NS_IN_S) / SystemCoreClock);
+}
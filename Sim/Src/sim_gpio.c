@@ -0,0 +1,135 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "main.h"
+#include "sim_gpio.h"
+#include "sim_os.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_GPIO_EXTI_FALLING_PIN       (INA226_ALERT_Pin)
+#define SIM_GPIO_EXTI_FALLING_PORT      (INA226_ALERT_GPIO_Port)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+GPIO_TypeDef Sim_Gpio[SIM_GPIO_PORTS_NUM];
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulated GPIO initialization function
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Gpio_Init(void)
+{
+    /* Open drain alert line - released (pulled up) */
+    SIM_GPIO_EXTI_FALLING_PORT->IDR |= SIM_GPIO_EXTI_FALLING_PIN;
+}
+
+/*!
+ * \brief Drive input pin - should be called from a simulated interrupt (Sim_Os_IrqEnter)
+ *
+ * \param[in] port GPIO port
+ * \param[in] pin GPIO pin
+ * \param[in] state New pin level
+ *
+ * \retval None
+ */
+void Sim_Gpio_SetInput(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state)
+{
+    bool falling = ((port->IDR & pin) != 0U) && (state == GPIO_PIN_RESET);
+
+    if(state == GPIO_PIN_SET)
+    {
+        port->IDR |= pin;
+    }
+    else
+    {
+        port->IDR &= ~(uint32_t)pin;
+    }
+
+    if((falling == true) && (port == SIM_GPIO_EXTI_FALLING_PORT) && (pin == SIM_GPIO_EXTI_FALLING_PIN))
+    {
+        HAL_GPIO_EXTI_Callback(pin);
+    }
+}
+
+/*!
+ * \brief Read input pin
+ *
+ * \param[in] GPIOx GPIO port
+ * \param[in] GPIO_Pin GPIO pin
+ *
+ * \retval Pin level
+ */
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    return ((GPIOx->IDR & GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+/*!
+ * \brief Write output pins
+ *
+ * \param[in] GPIOx GPIO port
+ * \param[in] GPIO_Pin GPIO pins
+ * \param[in] PinState New level
+ *
+ * \retval None
+ */
+void HAL_GPIO_WritePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    /* BSRR is atomic on the target */
+    Sim_Os_IrqEnter();
+
+    if(PinState == GPIO_PIN_SET)
+    {
+        GPIOx->ODR |= GPIO_Pin;
+    }
+    else
+    {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+
+    Sim_Os_IrqExit();
+}
+
+/*!
+ * \brief Toggle output pins
+ *
+ * \param[in] GPIOx GPIO port
+ * \param[in] GPIO_Pin GPIO pins
+ *
+ * \retval None
+ */
+void HAL_GPIO_TogglePin(GPIO_TypeDef* GPIOx, uint16_t GPIO_Pin)
+{
+    Sim_Os_IrqEnter();
+    GPIOx->ODR ^= GPIO_Pin;
+    Sim_Os_IrqExit();
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
@@ -0,0 +1,37 @@
+#ifndef _SIM_GPIO_H_
+#define _SIM_GPIO_H_
+
+/*
+ * Simulated GPIO - output levels are stored, input levels are driven by the simulated devices.
+ * A falling edge on the INA226 alert pin raises the EXTI callback.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include "stm32f7xx_hal.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_Gpio_Init(void);
+void Sim_Gpio_SetInput(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+
+#endif  /* _SIM_GPIO_H_ */
@@ -0,0 +1,345 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdbool.h>
+#include "i2c.h"
+#include "sim_i2c.h"
+#include "sim_ina226.h"
+#include "sim_os.h"
+#include "sim_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_I2C_FRAME_BITS      (2U)    /* Start and stop condition */
+#define SIM_I2C_ADDRESSES_NUM   (128U)  /* 7-bit addresses */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef struct
+{
+    I2C_HandleTypeDef* hi2c;
+    uint8_t address;                /* 7-bit address */
+    uint8_t* data;
+    uint16_t size;
+    bool read;
+    uint64_t start;                 /* Start of the transfer in ns */
+}Sim_I2c_Transfer_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static HAL_StatusTypeDef Sim_I2c_Start(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, bool read,
+                                       bool dma);
+static void* Sim_I2c_Thread(void* arg);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+I2C_TypeDef Sim_I2c1;
+I2C_HandleTypeDef hi2c1 = {.Instance = I2C1};
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static pthread_mutex_t Sim_I2c_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Sim_I2c_Cond;
+static Sim_I2c_Transfer_t Sim_I2c_Transfer;
+static bool Sim_I2c_Pending;        /* Transfer waits for the bus thread */
+static bool Sim_I2c_Busy;           /* Transfer started and not completed */
+static bool Sim_I2c_Abort;          /* Abort of the running transfer requested */
+static Sim_I2c_Fault_t Sim_I2c_Faults[SIM_I2C_ADDRESSES_NUM];
+static Sim_I2c_Stats_t Sim_I2c_Stats;
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulated I2C initialization function
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_I2c_Init(void)
+{
+    Sim_Os_CondInit(&Sim_I2c_Cond);
+
+    (void)Sim_Os_CreateIrqThread("Sim_I2c", Sim_I2c_Thread, SIM_I2C_NVIC_PRIORITY);
+}
+
+/*!
+ * \brief Start interrupt driven master transmission
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ * \param[in] pData Transmitted data
+ * \param[in] Size Number of bytes
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size)
+{
+    return Sim_I2c_Start(hi2c, DevAddress, pData, Size, false, false);
+}
+
+/*!
+ * \brief Start interrupt driven master reception
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ * \param[out] pData Received data
+ * \param[in] Size Number of bytes
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                            uint16_t Size)
+{
+    return Sim_I2c_Start(hi2c, DevAddress, pData, Size, true, false);
+}
+
+/*!
+ * \brief Start DMA master transmission
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ * \param[in] pData Transmitted data
+ * \param[in] Size Number of bytes
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                              uint16_t Size)
+{
+    return Sim_I2c_Start(hi2c, DevAddress, pData, Size, false, true);
+}
+
+/*!
+ * \brief Start DMA master reception
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ * \param[out] pData Received data
+ * \param[in] Size Number of bytes
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Receive_DMA(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData,
+                                             uint16_t Size)
+{
+    return Sim_I2c_Start(hi2c, DevAddress, pData, Size, true, true);
+}
+
+/*!
+ * \brief Start abort of the running transfer - the bus thread stops it and calls the abort complete callback
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ *
+ * \retval HAL_OK - abort started, HAL_ERROR - no transfer is running
+ */
+HAL_StatusTypeDef HAL_I2C_Master_Abort_IT(I2C_HandleTypeDef *hi2c, uint16_t DevAddress)
+{
+    HAL_StatusTypeDef ret_val = HAL_ERROR;
+
+    (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+
+    if((Sim_I2c_Busy == true) && (Sim_I2c_Transfer.hi2c == hi2c) && (Sim_I2c_Transfer.address == (uint8_t)(DevAddress >> 1U)))
+    {
+        Sim_I2c_Abort = true;
+        (void)pthread_cond_signal(&Sim_I2c_Cond);
+        ret_val = HAL_OK;
+    }
+
+    (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+
+    return ret_val;
+}
+
+/*!
+ * \brief Inject a fault of one device - should be called before the simulation starts
+ *
+ * \param[in] address 7-bit address
+ * \param[in] fault Fault of the device, Sim_I2c_FaultNone removes it
+ *
+ * \retval None
+ */
+void Sim_I2c_SetFault(uint8_t address, Sim_I2c_Fault_t fault)
+{
+    if(address < SIM_I2C_ADDRESSES_NUM)
+    {
+        (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+        Sim_I2c_Faults[address] = fault;
+        (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+    }
+}
+
+/*!
+ * \brief Transfers started so far
+ *
+ * \param[out] stats Transfer counters
+ *
+ * \retval None
+ */
+void Sim_I2c_GetStats(Sim_I2c_Stats_t* stats)
+{
+    (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+    *stats = Sim_I2c_Stats;
+    (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Hand the transfer over to the bus thread
+ *
+ * \param[in] hi2c I2C handle
+ * \param[in] DevAddress Device address shifted left by one
+ * \param[in] pData Transfer data
+ * \param[in] Size Number of bytes
+ * \param[in] read true - reception, false - transmission
+ * \param[in] dma true - DMA transfer, false - interrupt transfer
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+static HAL_StatusTypeDef Sim_I2c_Start(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint8_t *pData, uint16_t Size, bool read,
+                                       bool dma)
+{
+    HAL_StatusTypeDef ret_val = HAL_BUSY;
+
+    (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+
+    if(Sim_I2c_Busy == false)
+    {
+        Sim_I2c_Transfer.hi2c = hi2c;
+        Sim_I2c_Transfer.address = (uint8_t)(DevAddress >> 1U);
+        Sim_I2c_Transfer.data = pData;
+        Sim_I2c_Transfer.size = Size;
+        Sim_I2c_Transfer.read = read;
+        Sim_I2c_Transfer.start = Sim_Os_GetTimeNs();
+        Sim_I2c_Busy = true;
+        Sim_I2c_Pending = true;
+        hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+
+        if(dma == true)
+        {
+            Sim_I2c_Stats.dma_transfers++;
+        }
+        else
+        {
+            Sim_I2c_Stats.it_transfers++;
+        }
+
+        Sim_I2c_Stats.bytes += Size;
+        (void)pthread_cond_signal(&Sim_I2c_Cond);
+        ret_val = HAL_OK;
+    }
+
+    (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+
+    return ret_val;
+}
+
+/*!
+ * \brief Bus thread - waits for the transfer time or the abort, accesses the device and runs the callback
+ *        as a simulated interrupt
+ *
+ * \param[in] arg Not used
+ *
+ * \retval NULL
+ */
+static void* Sim_I2c_Thread(void* arg)
+{
+    Sim_I2c_Transfer_t transfer;
+    Sim_I2c_Fault_t fault;
+    uint64_t bits;
+    uint64_t end;
+    bool abort;
+    bool ack;
+
+    for(;;)
+    {
+        (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+
+        while(Sim_I2c_Pending == false)
+        {
+            (void)pthread_cond_wait(&Sim_I2c_Cond, &Sim_I2c_Mutex);
+        }
+
+        transfer = Sim_I2c_Transfer;
+        fault = Sim_I2c_Faults[transfer.address];
+        Sim_I2c_Pending = false;
+
+        /* A stalled device holds the clock low - only the abort ends the transfer */
+        bits = ((1ULL + transfer.size) * SIM_I2C_BYTE_BITS) + SIM_I2C_FRAME_BITS;
+        end = (fault == Sim_I2c_FaultStalled) ? UINT64_MAX : (transfer.start + ((bits * SIM_OS_NS_IN_S) / SIM_I2C_BIT_RATE_HZ));
+
+        while((Sim_I2c_Abort == false) && (Sim_Os_GetTimeNs() < end))
+        {
+            (void)Sim_Os_CondWaitUntil(&Sim_I2c_Cond, &Sim_I2c_Mutex, end);
+        }
+
+        (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+
+        Sim_Os_IrqEnter();
+
+        /* The abort may come until the interrupt runs. The callback may start the next transfer. */
+        (void)pthread_mutex_lock(&Sim_I2c_Mutex);
+        abort = Sim_I2c_Abort;
+        Sim_I2c_Abort = false;
+        Sim_I2c_Busy = false;
+        Sim_I2c_Stats.aborts += (abort == true) ? 1U : 0U;
+        (void)pthread_mutex_unlock(&Sim_I2c_Mutex);
+
+        if(fault != Sim_I2c_FaultNone)
+        {
+            ack = false;
+        }
+        else if(abort == true)
+        {
+            ack = false;    /* STOP generated before the end, the device is not accessed */
+        }
+        else if(transfer.read == true)
+        {
+            ack = Sim_Ina226_Read(transfer.address, transfer.data, transfer.size);
+        }
+        else
+        {
+            ack = Sim_Ina226_Write(transfer.address, transfer.data, transfer.size);
+        }
+
+        if(abort == true)
+        {
+            HAL_I2C_AbortCpltCallback(transfer.hi2c);
+        }
+        else if(ack == false)
+        {
+            transfer.hi2c->ErrorCode = HAL_I2C_ERROR_AF;
+            HAL_I2C_ErrorCallback(transfer.hi2c);
+        }
+        else if(transfer.read == true)
+        {
+            HAL_I2C_MasterRxCpltCallback(transfer.hi2c);
+        }
+        else
+        {
+            HAL_I2C_MasterTxCpltCallback(transfer.hi2c);
+        }
+
+        Sim_Os_IrqExit();
+    }
+
+    return NULL;
+}
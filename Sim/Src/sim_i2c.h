@@ -0,0 +1,56 @@
+#ifndef _SIM_I2C_H_
+#define _SIM_I2C_H_
+
+/*
+ * Simulated I2C1 master - one transfer at a time, completed by the bus thread after the transfer time
+ * with the HAL complete or error callback. Interrupt and DMA transfers behave the same, they are only
+ * counted separately. A transfer can be aborted, it ends with the abort complete callback. Faults of
+ * single devices can be injected: an absent device does not acknowledge, a stalled one holds the
+ * clock low, so its transfers end only by an abort.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef enum
+{
+    Sim_I2c_FaultNone = 0,
+    Sim_I2c_FaultAbsent,            /* Address not acknowledged */
+    Sim_I2c_FaultStalled            /* Clock stretched forever */
+}Sim_I2c_Fault_t;
+
+typedef struct
+{
+    uint32_t it_transfers;          /* Started by HAL_I2C_Master_*_IT */
+    uint32_t dma_transfers;         /* Started by HAL_I2C_Master_*_DMA */
+    uint32_t bytes;                 /* Data bytes of all transfers, address bytes not included */
+    uint32_t aborts;                /* Transfers ended by HAL_I2C_Master_Abort_IT */
+}Sim_I2c_Stats_t;
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_I2c_Init(void);
+void Sim_I2c_SetFault(uint8_t address, Sim_I2c_Fault_t fault);
+void Sim_I2c_GetStats(Sim_I2c_Stats_t* stats);
+
+#endif  /* _SIM_I2C_H_ */
@@ -0,0 +1,644 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdlib.h>
+#include <math.h>
+#include "main.h"
+#include "ina226_reg.h"
+#include "sim_ina226.h"
+#include "sim_gpio.h"
+#include "sim_os.h"
+#include "sim_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_INA226_REGS_NUM             (8U)
+#define SIM_INA226_NS_IN_US             (1000ULL)
+
+/* Power-on register values */
+#define SIM_INA226_RESET_CONFIGURATION  (0x4127U)
+#define SIM_INA226_MANUFACTURER_ID      (0x5449U)
+#define SIM_INA226_DIE_ID               (0x2260U)
+
+/* Mode field - bit 2 selects continuous conversions */
+#define SIM_INA226_MODE_MASK            (0x07U)
+#define SIM_INA226_MODE_CONTINUOUS      (0x04U)
+
+/* Mask/Enable register */
+#define SIM_INA226_MASK_LEN             (1U << INA226_POS_MASK_ENABLE_LEN)
+#define SIM_INA226_MASK_APOL            (1U << INA226_POS_MASK_ENABLE_APOL)
+#define SIM_INA226_MASK_CVRF            (1U << INA226_POS_MASK_ENABLE_CVRF)
+#define SIM_INA226_MASK_AFF             (1U << INA226_POS_MASK_ENABLE_AFF)
+#define SIM_INA226_MASK_CNVR            (1U << INA226_POS_MASK_ENABLE_CNVR)
+#define SIM_INA226_MASK_READ_ONLY       (0x001CU)   /* AFF, CVRF, OVF */
+
+/* Current = Shunt * CAL / 2048, Power = Current * Bus / 20000 */
+#define SIM_INA226_CURRENT_DIVIDER      (2048)
+#define SIM_INA226_POWER_DIVIDER        (20000)
+#define SIM_INA226_BUS_VOLTAGE_MAX      (0x7FFF)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef struct
+{
+    uint8_t address;
+    int32_t bus_voltage;            /* Bus voltage of the constant profile in uV */
+    int32_t current;                /* Load current of the constant profile in uA */
+    Sim_Waveform_t waveform;        /* True bus voltage and load current */
+    uint16_t reg[SIM_INA226_REGS_NUM];
+    uint8_t pointer;                /* Register pointer */
+    uint64_t next;                  /* End of the running conversion in ns, UINT64_MAX - idle */
+}Sim_Ina226_Device_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void* Sim_Ina226_Thread(void* arg);
+static Sim_Ina226_Device_t* Sim_Ina226_Find(uint8_t address);
+static void Sim_Ina226_Reset(Sim_Ina226_Device_t* device);
+static void Sim_Ina226_Timing(const Sim_Ina226_Device_t* device, uint64_t* shunt_time, uint64_t* bus_time, uint32_t* averages);
+static void Sim_Ina226_Start(Sim_Ina226_Device_t* device, uint64_t time);
+static void Sim_Ina226_Convert(Sim_Ina226_Device_t* device);
+static bool Sim_Ina226_AlertFunction(const Sim_Ina226_Device_t* device);
+static void Sim_Ina226_UpdateAlert(void);
+static uint16_t Sim_Ina226_Clamp(int64_t value, int64_t min, int64_t max);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static Sim_Ina226_Device_t Sim_Ina226_Devices[] =
+{
+    #define SIM_INA226_CFG_DEVICE(addr, bus_uv, current_ua) { \
+        .address = (addr), \
+        .bus_voltage = (bus_uv), \
+        .current = (current_ua)},
+        SIM_INA226_CFG_TABLE
+    #undef SIM_INA226_CFG_DEVICE
+};
+
+#define SIM_INA226_DEVICES_NUM          (sizeof(Sim_Ina226_Devices) / sizeof(Sim_Ina226_Devices[0]))
+
+static const uint32_t Sim_Ina226_ConversionTime[] = INA226_CONVERSION_TIME_US;
+static const uint32_t Sim_Ina226_Averages[] = INA226_AVERAGES;
+
+/* Conversion thread wake-up - a configuration write may shorten the wait */
+static pthread_mutex_t Sim_Ina226_Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Sim_Ina226_Cond;
+static bool Sim_Ina226_Wake;
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulated INA226 initialization function - devices start at the power-on state
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Ina226_Init(void)
+{
+    Sim_Os_CondInit(&Sim_Ina226_Cond);
+
+    for(uint32_t i = 0U; i < SIM_INA226_DEVICES_NUM; i++)
+    {
+        if(Sim_Ina226_Devices[i].waveform.num == 0U)
+        {
+            Sim_Waveform_Constant(&Sim_Ina226_Devices[i].waveform, Sim_Ina226_Devices[i].bus_voltage, Sim_Ina226_Devices[i].current);
+        }
+
+        Sim_Ina226_Reset(&Sim_Ina226_Devices[i]);
+        Sim_Ina226_Start(&Sim_Ina226_Devices[i], 0U);
+    }
+
+    (void)Sim_Os_CreateIrqThread("Sim_Ina226", Sim_Ina226_Thread, SIM_INA226_NVIC_PRIORITY);
+}
+
+/*!
+ * \brief Load profile of the device - the constant values of the configuration are used without it
+ *
+ * \param[in] device Index in SIM_INA226_CFG_TABLE
+ * \param[in] path CSV or binary file (sim_waveform.h)
+ *
+ * \retval Status code
+ */
+uint8_t Sim_Ina226_LoadWaveform(uint32_t device, const char* path)
+{
+    if(device >= SIM_INA226_DEVICES_NUM)
+    {
+        return SIM_WAVEFORM_CODE_NOT_OK;
+    }
+
+    return Sim_Waveform_Load(&Sim_Ina226_Devices[device].waveform, path);
+}
+
+/*!
+ * \brief Get profile of the device
+ *
+ * \param[in] address 7-bit I2C address
+ *
+ * \retval Profile, NULL if there is no device at the address
+ */
+const Sim_Waveform_t* Sim_Ina226_GetWaveform(uint8_t address)
+{
+    Sim_Ina226_Device_t* device = Sim_Ina226_Find(address);
+
+    return (device != NULL) ? &device->waveform : NULL;
+}
+
+/*!
+ * \brief Get conversion timing of the device as configured by the firmware
+ *
+ * \param[in] address 7-bit I2C address
+ * \param[out] shunt_time Shunt conversion time in ns, 0 if the shunt is not converted
+ * \param[out] bus_time Bus voltage conversion time in ns, 0 if the bus voltage is not converted
+ * \param[out] averages Number of averaged conversions
+ *
+ * \retval true if there is a device at the address
+ */
+bool Sim_Ina226_GetTiming(uint8_t address, uint64_t* shunt_time, uint64_t* bus_time, uint32_t* averages)
+{
+    Sim_Ina226_Device_t* device;
+
+    Sim_Os_IrqEnter();
+
+    device = Sim_Ina226_Find(address);
+    if(device != NULL)
+    {
+        Sim_Ina226_Timing(device, shunt_time, bus_time, averages);
+    }
+
+    Sim_Os_IrqExit();
+
+    return (device != NULL);
+}
+
+/*!
+ * \brief I2C write to the device - register pointer and optionally the register value (MSB first)
+ *
+ * \param[in] address 7-bit I2C address
+ * \param[in] data Transmitted bytes
+ * \param[in] size Number of bytes
+ *
+ * \retval true - acknowledged, false - no device at the address
+ */
+bool Sim_Ina226_Write(uint8_t address, const uint8_t* data, uint16_t size)
+{
+    Sim_Ina226_Device_t* device = Sim_Ina226_Find(address);
+    uint16_t value;
+
+    if(device == NULL)
+    {
+        return false;
+    }
+
+    if(size >= 1U)
+    {
+        device->pointer = data[0];
+    }
+
+    if((size >= 3U) && (device->pointer < SIM_INA226_REGS_NUM))
+    {
+        value = (uint16_t)(((uint16_t)data[1] << 8U) | data[2]);
+
+        switch(device->pointer)
+        {
+            case INA226_REG_CONFIGURATION:
+                if((value & (1U << INA226_POS_CONFIGURATION_RST)) != 0U)
+                {
+                    Sim_Ina226_Reset(device);
+                }
+                else
+                {
+                    device->reg[INA226_REG_CONFIGURATION] = value;
+                    device->reg[INA226_REG_MASK_ENABLE] &= (uint16_t)~SIM_INA226_MASK_CVRF;
+                }
+                Sim_Ina226_Start(device, Sim_Os_GetTimeNs());
+                break;
+
+            case INA226_REG_CALIBRATION:
+                device->reg[INA226_REG_CALIBRATION] = value & (uint16_t)INA226_CALIBRATION_MAX;
+                break;
+
+            case INA226_REG_MASK_ENABLE:
+                device->reg[INA226_REG_MASK_ENABLE] = (value & (uint16_t)~SIM_INA226_MASK_READ_ONLY) |
+                                                      (device->reg[INA226_REG_MASK_ENABLE] & SIM_INA226_MASK_READ_ONLY);
+                break;
+
+            case INA226_REG_ALERT_LIMIT:
+                device->reg[INA226_REG_ALERT_LIMIT] = value;
+                break;
+
+            default:
+                /* Result registers are read-only */
+                break;
+        }
+
+        Sim_Ina226_UpdateAlert();
+    }
+
+    return true;
+}
+
+/*!
+ * \brief I2C read from the device - the register at the pointer (MSB first). Reading Mask/Enable
+ *        clears the conversion ready flag and the latched alert function flag.
+ *
+ * \param[in] address 7-bit I2C address
+ * \param[out] data Received bytes
+ * \param[in] size Number of bytes
+ *
+ * \retval true - acknowledged, false - no device at the address
+ */
+bool Sim_Ina226_Read(uint8_t address, uint8_t* data, uint16_t size)
+{
+    Sim_Ina226_Device_t* device = Sim_Ina226_Find(address);
+    uint16_t value = 0U;
+    uint16_t* mask;
+
+    if(device == NULL)
+    {
+        return false;
+    }
+
+    if(device->pointer < SIM_INA226_REGS_NUM)
+    {
+        value = device->reg[device->pointer];
+    }
+    else if(device->pointer == INA226_REG_MANUFACTURER_ID)
+    {
+        value = SIM_INA226_MANUFACTURER_ID;
+    }
+    else if(device->pointer == INA226_REG_DIE_ID)
+    {
+        value = SIM_INA226_DIE_ID;
+    }
+
+    for(uint16_t i = 0U; i < size; i++)
+    {
+        data[i] = ((i & 1U) == 0U) ? (uint8_t)(value >> 8U) : (uint8_t)value;
+    }
+
+    if(device->pointer == INA226_REG_MASK_ENABLE)
+    {
+        mask = &device->reg[INA226_REG_MASK_ENABLE];
+        *mask &= (uint16_t)~SIM_INA226_MASK_CVRF;
+
+        if((*mask & SIM_INA226_MASK_LEN) != 0U)
+        {
+            *mask &= (uint16_t)~SIM_INA226_MASK_AFF;
+        }
+
+        Sim_Ina226_UpdateAlert();
+    }
+
+    return true;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Conversion thread - completes the due conversions of all devices as a simulated interrupt
+ *
+ * \param[in] arg Not used
+ *
+ * \retval NULL
+ */
+static void* Sim_Ina226_Thread(void* arg)
+{
+    uint64_t next;
+    uint64_t now;
+
+    for(;;)
+    {
+        Sim_Os_IrqEnter();
+
+        now = Sim_Os_GetTimeNs();
+        next = UINT64_MAX;
+
+        for(uint32_t i = 0U; i < SIM_INA226_DEVICES_NUM; i++)
+        {
+            Sim_Ina226_Device_t* device = &Sim_Ina226_Devices[i];
+
+            /* Conversions missed by a host stall are completed at once, the last one is visible */
+            while(device->next <= now)
+            {
+                Sim_Ina226_Convert(device);
+            }
+
+            if(device->next < next)
+            {
+                next = device->next;
+            }
+        }
+
+        Sim_Ina226_UpdateAlert();
+
+        Sim_Os_IrqExit();
+
+        (void)pthread_mutex_lock(&Sim_Ina226_Mutex);
+
+        while(Sim_Ina226_Wake == false)
+        {
+            if(Sim_Os_CondWaitUntil(&Sim_Ina226_Cond, &Sim_Ina226_Mutex, next) == false)
+            {
+                break;
+            }
+        }
+
+        Sim_Ina226_Wake = false;
+        (void)pthread_mutex_unlock(&Sim_Ina226_Mutex);
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Find device by the address
+ *
+ * \param[in] address 7-bit I2C address
+ *
+ * \retval Device, NULL if there is no device at the address
+ */
+static Sim_Ina226_Device_t* Sim_Ina226_Find(uint8_t address)
+{
+    for(uint32_t i = 0U; i < SIM_INA226_DEVICES_NUM; i++)
+    {
+        if(Sim_Ina226_Devices[i].address == address)
+        {
+            return &Sim_Ina226_Devices[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Set power-on register values
+ *
+ * \param[in] device Device
+ *
+ * \retval None
+ */
+static void Sim_Ina226_Reset(Sim_Ina226_Device_t* device)
+{
+    for(uint32_t i = 0U; i < SIM_INA226_REGS_NUM; i++)
+    {
+        device->reg[i] = 0U;
+    }
+
+    device->reg[INA226_REG_CONFIGURATION] = SIM_INA226_RESET_CONFIGURATION;
+    device->pointer = INA226_REG_CONFIGURATION;
+}
+
+/*!
+ * \brief Get conversion timing of the configuration
+ *
+ * \param[in] device Device
+ * \param[out] shunt_time Shunt conversion time in ns, 0 if the shunt is not converted
+ * \param[out] bus_time Bus voltage conversion time in ns, 0 if the bus voltage is not converted
+ * \param[out] averages Number of averaged conversions
+ *
+ * \retval None
+ */
+static void Sim_Ina226_Timing(const Sim_Ina226_Device_t* device, uint64_t* shunt_time, uint64_t* bus_time, uint32_t* averages)
+{
+    uint16_t configuration = device->reg[INA226_REG_CONFIGURATION];
+    uint16_t mode = configuration & SIM_INA226_MODE_MASK;
+
+    *shunt_time = 0U;
+    *bus_time = 0U;
+    *averages = Sim_Ina226_Averages[(configuration >> INA226_POS_CONFIGURATION_AVG) & INA226_MAX_CONFIGURATION_AVG];
+
+    if((mode & INA226_MODE_SHUNT) != 0U)
+    {
+        *shunt_time = Sim_Ina226_ConversionTime[(configuration >> INA226_POS_CONFIGURATION_VSHCT) & INA226_MAX_CONFIGURATION_VSHCT] *
+                      SIM_INA226_NS_IN_US;
+    }
+
+    if((mode & INA226_MODE_BUS) != 0U)
+    {
+        *bus_time = Sim_Ina226_ConversionTime[(configuration >> INA226_POS_CONFIGURATION_VBUSCT) & INA226_MAX_CONFIGURATION_VBUSCT] *
+                    SIM_INA226_NS_IN_US;
+    }
+}
+
+/*!
+ * \brief Start conversion cycle after a configuration change
+ *
+ * \param[in] device Device
+ * \param[in] time Time of the configuration change in ns
+ *
+ * \retval None
+ */
+static void Sim_Ina226_Start(Sim_Ina226_Device_t* device, uint64_t time)
+{
+    uint64_t shunt_time;
+    uint64_t bus_time;
+    uint32_t averages;
+    uint64_t period;
+
+    Sim_Ina226_Timing(device, &shunt_time, &bus_time, &averages);
+    period = (shunt_time + bus_time) * averages;
+
+    /* Power-down modes convert nothing */
+    device->next = (period != 0U) ? (time + period) : UINT64_MAX;
+
+    (void)pthread_mutex_lock(&Sim_Ina226_Mutex);
+    Sim_Ina226_Wake = true;
+    (void)pthread_cond_signal(&Sim_Ina226_Cond);
+    (void)pthread_mutex_unlock(&Sim_Ina226_Mutex);
+}
+
+/*!
+ * \brief Complete the running conversion - result registers, flags and the next conversion
+ *
+ * \param[in] device Device
+ *
+ * \retval None
+ */
+static void Sim_Ina226_Convert(Sim_Ina226_Device_t* device)
+{
+    uint16_t mode = device->reg[INA226_REG_CONFIGURATION] & SIM_INA226_MODE_MASK;
+    uint16_t* mask = &device->reg[INA226_REG_MASK_ENABLE];
+    uint64_t end = device->next;
+    Sim_Waveform_Integral_t integral;
+    uint64_t shunt_time;
+    uint64_t bus_time;
+    uint32_t averages;
+    uint64_t start;
+    double shunt_sum = 0.0;
+    double bus_sum = 0.0;
+    int64_t shunt;
+    int64_t current;
+    int64_t bus;
+
+    Sim_Ina226_Timing(device, &shunt_time, &bus_time, &averages);
+    start = end - ((shunt_time + bus_time) * averages);
+
+    /* Each conversion integrates its input over its own window - shunt first, then bus */
+    for(uint32_t i = 0U; i < averages; i++)
+    {
+        if(shunt_time != 0U)
+        {
+            Sim_Waveform_Integrate(&device->waveform, start, start + shunt_time, &integral);
+            shunt_sum += integral.current / (double)shunt_time;
+        }
+
+        start += shunt_time;
+
+        if(bus_time != 0U)
+        {
+            Sim_Waveform_Integrate(&device->waveform, start, start + bus_time, &integral);
+            bus_sum += integral.bus_voltage / (double)bus_time;
+        }
+
+        start += bus_time;
+    }
+
+    if((mode & INA226_MODE_SHUNT) != 0U)
+    {
+        /* uA * uOhm = pV */
+        shunt = llround(((shunt_sum / averages) * (double)SIM_INA226_SHUNT_RESISTANCE_UOHM) / (1000.0 * INA226_SHUNT_VOLTAGE_LSB_NV));
+        device->reg[INA226_REG_SHUNT_VOLTAGE] = Sim_Ina226_Clamp(shunt, INT16_MIN, INT16_MAX);
+    }
+
+    if((mode & INA226_MODE_BUS) != 0U)
+    {
+        bus = llround((bus_sum / averages) / INA226_BUS_VOLTAGE_LSB_UV);
+        device->reg[INA226_REG_BUS_VOLTAGE] = Sim_Ina226_Clamp(bus, 0, SIM_INA226_BUS_VOLTAGE_MAX);
+    }
+
+    shunt = (int16_t)device->reg[INA226_REG_SHUNT_VOLTAGE];
+    bus = device->reg[INA226_REG_BUS_VOLTAGE];
+    current = (shunt * device->reg[INA226_REG_CALIBRATION]) / SIM_INA226_CURRENT_DIVIDER;
+    device->reg[INA226_REG_CURRENT] = Sim_Ina226_Clamp(current, INT16_MIN, INT16_MAX);
+    current = (int16_t)device->reg[INA226_REG_CURRENT];
+    device->reg[INA226_REG_POWER] = Sim_Ina226_Clamp((llabs(current) * bus) / SIM_INA226_POWER_DIVIDER, 0, UINT16_MAX);
+
+    *mask |= SIM_INA226_MASK_CVRF;
+
+    if(Sim_Ina226_AlertFunction(device) == true)
+    {
+        *mask |= SIM_INA226_MASK_AFF;
+    }
+    else if((*mask & SIM_INA226_MASK_LEN) == 0U)
+    {
+        /* Transparent mode - the flag follows the limit */
+        *mask &= (uint16_t)~SIM_INA226_MASK_AFF;
+    }
+
+    /* Triggered modes convert once */
+    device->next = UINT64_MAX;
+
+    if((mode & SIM_INA226_MODE_CONTINUOUS) != 0U)
+    {
+        Sim_Ina226_Start(device, end);
+    }
+}
+
+/*!
+ * \brief Check the selected alert function limit - the highest enabled function is used
+ *
+ * \param[in] device Device
+ *
+ * \retval true - limit exceeded, otherwise false
+ */
+static bool Sim_Ina226_AlertFunction(const Sim_Ina226_Device_t* device)
+{
+    uint16_t mask = device->reg[INA226_REG_MASK_ENABLE];
+    uint16_t limit = device->reg[INA226_REG_ALERT_LIMIT];
+    int16_t shunt = (int16_t)device->reg[INA226_REG_SHUNT_VOLTAGE];
+    uint16_t bus = device->reg[INA226_REG_BUS_VOLTAGE];
+
+    if((mask & (1U << INA226_POS_MASK_ENABLE_SOL)) != 0U)
+    {
+        return (shunt > (int16_t)limit);
+    }
+
+    if((mask & (1U << INA226_POS_MASK_ENABLE_SUL)) != 0U)
+    {
+        return (shunt < (int16_t)limit);
+    }
+
+    if((mask & (1U << INA226_POS_MASK_ENABLE_BOL)) != 0U)
+    {
+        return (bus > limit);
+    }
+
+    if((mask & (1U << INA226_POS_MASK_ENABLE_BUL)) != 0U)
+    {
+        return (bus < limit);
+    }
+
+    if((mask & (1U << INA226_POS_MASK_ENABLE_POL)) != 0U)
+    {
+        return (device->reg[INA226_REG_POWER] > limit);
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Drive the shared ALERT line - open drain, low while any device pulls it
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+static void Sim_Ina226_UpdateAlert(void)
+{
+    GPIO_PinState state = GPIO_PIN_SET;
+
+    for(uint32_t i = 0U; i < SIM_INA226_DEVICES_NUM; i++)
+    {
+        uint16_t mask = Sim_Ina226_Devices[i].reg[INA226_REG_MASK_ENABLE];
+        bool active = ((mask & SIM_INA226_MASK_AFF) != 0U) ||
+                      (((mask & SIM_INA226_MASK_CNVR) != 0U) && ((mask & SIM_INA226_MASK_CVRF) != 0U));
+
+        /* APOL inverts the pin - released while active */
+        if(active != ((mask & SIM_INA226_MASK_APOL) != 0U))
+        {
+            state = GPIO_PIN_RESET;
+        }
+    }
+
+    Sim_Gpio_SetInput(INA226_ALERT_GPIO_Port, INA226_ALERT_Pin, state);
+}
+
+/*!
+ * \brief Saturate value to the register range
+ *
+ * \param[in] value Value
+ * \param[in] min Minimum
+ * \param[in] max Maximum
+ *
+ * \retval Register value
+ */
+static uint16_t Sim_Ina226_Clamp(int64_t value, int64_t min, int64_t max)
+{
+    if(value < min)
+    {
+        value = min;
+    }
+    else if(value > max)
+    {
+        value = max;
+    }
+
+    return (uint16_t)value;
+}
@@ -0,0 +1,46 @@
+#ifndef _SIM_INA226_H_
+#define _SIM_INA226_H_
+
+/*
+ * Simulated INA226 devices - register model of the I2C slaves. Conversions follow the configured
+ * operating mode, conversion times and averaging: each shunt and bus conversion is the mean of the
+ * load profile (sim_waveform.h) over its own window, the averaged results are computed with the
+ * datasheet formulas. The ALERT line signals conversion ready and the alert function.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim_waveform.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API - Write and Read should be called from a simulated interrupt (Sim_Os_IrqEnter), waveforms
+ * should be loaded before Sim_Ina226_Init
+ */
+void Sim_Ina226_Init(void);
+uint8_t Sim_Ina226_LoadWaveform(uint32_t device, const char* path);
+const Sim_Waveform_t* Sim_Ina226_GetWaveform(uint8_t address);
+bool Sim_Ina226_GetTiming(uint8_t address, uint64_t* shunt_time, uint64_t* bus_time, uint32_t* averages);
+bool Sim_Ina226_Write(uint8_t address, const uint8_t* data, uint16_t size);
+bool Sim_Ina226_Read(uint8_t address, uint8_t* data, uint16_t size);
+
+#endif  /* _SIM_INA226_H_ */
@@ -0,0 +1,185 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "cmsis_os.h"
+#include "dwt.h"
+#include "log.h"
+#include "trace.h"
+#include "sim_os.h"
+#include "sim_gpio.h"
+#include "sim_ina226.h"
+#include "sim_i2c.h"
+#include "sim_uart.h"
+#include "sim_report.h"
+
+#include "hal_energy_monitor.h"
+#include "hal_uart.h"
+#include "app_energy_monitor.h"
+#include "app_log.h"
+#include "app_command.h"
+#include "app_bench.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void Sim_Main_Usage(const char* name);
+static void* Sim_Main_StopThread(void* arg);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Host simulation entry point - same initialization order as the target main()
+ *
+ * \param[in] argc Number of arguments
+ * \param[in] argv Options, see Sim_Main_Usage
+ *
+ * \retval Exit status
+ */
+int main(int argc, char* argv[])
+{
+    uint64_t run_time = 0U;
+    uint32_t device = 0U;
+    pthread_t thread;
+    int option;
+
+    while((option = getopt(argc, argv, "t:w:x:s:")) != -1)
+    {
+        switch(option)
+        {
+            case 't':
+                run_time = strtoull(optarg, NULL, 10);
+                break;
+
+            case 'w':
+                if(Sim_Ina226_LoadWaveform(device, optarg) != SIM_WAVEFORM_CODE_OK)
+                {
+                    (void)fprintf(stderr, "Cannot load waveform %s for device %u\n", optarg, (unsigned int)device);
+                    return EXIT_FAILURE;
+                }
+
+                device++;
+                break;
+
+            case 'x':
+                Sim_I2c_SetFault((uint8_t)strtoul(optarg, NULL, 0), Sim_I2c_FaultAbsent);
+                break;
+
+            case 's':
+                Sim_I2c_SetFault((uint8_t)strtoul(optarg, NULL, 0), Sim_I2c_FaultStalled);
+                break;
+
+            default:
+                Sim_Main_Usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    Sim_Os_Init();
+
+    /* Cycle counter for timestamps */
+    Dwt_Init();
+
+    /* Log queue - records may be written from now on */
+    Log_Init();
+
+    /* Trace recorder - events are recorded from now on */
+    Trace_Init();
+
+    /* Simulated peripherals */
+    Sim_Gpio_Init();
+    Sim_Ina226_Init();
+    Sim_I2c_Init();
+    Sim_Uart_Init();
+
+    /* HAL layer initialization - sensors are configured later by the energy monitor task */
+    Hal_EnergyMonitor_Init();
+    Hal_Uart_Init();
+
+    /* APP layer initialization */
+    App_EnergyMonitor_Init();
+    App_Log_Init();
+    App_Command_Init();
+
+#if (BENCH_ENABLE == 1U)
+    /* Benchmark build - the harness task runs above the application */
+    App_Bench_Init();
+#endif
+
+    /* Measured against true energy from the first sample on */
+    Sim_Report_Init();
+
+    if(run_time != 0U)
+    {
+        if(pthread_create(&thread, NULL, Sim_Main_StopThread, &run_time) != 0)
+        {
+            return EXIT_FAILURE;
+        }
+    }
+
+    /* Start scheduler */
+    (void)osKernelStart();
+
+    return EXIT_SUCCESS;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Print command line options
+ *
+ * \param[in] name Program name
+ *
+ * \retval None
+ */
+static void Sim_Main_Usage(const char* name)
+{
+    (void)fprintf(stderr, "Usage: %s [-t seconds] [-w waveform]... [-x address]... [-s address]...\n"
+                          "  -t  Run time, then print the energy report to stderr - runs forever without it\n"
+                          "  -w  Load profile (CSV or binary, see sim_waveform.h) of the next INA226 in SIM_INA226_CFG_TABLE\n"
+                          "  -x  INA226 at the I2C address is absent - not acknowledged\n"
+                          "  -s  INA226 at the I2C address stalls the bus - its transfers end only by an abort\n",
+                  name);
+}
+
+/*!
+ * \brief Stop the simulation after the run time and print the report
+ *
+ * \param[in] arg Run time in seconds
+ *
+ * \retval None
+ */
+static void* Sim_Main_StopThread(void* arg)
+{
+    Sim_Os_SleepUntil(*(const uint64_t*)arg * SIM_OS_NS_IN_S);
+
+    (void)fflush(stdout);
+    Sim_Report_Print(stderr);
+    exit(EXIT_SUCCESS);
+
+    return NULL;
+}
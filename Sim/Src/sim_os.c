@@ -0,0 +1,704 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <stdatomic.h>
+#include "cmsis_os.h"
+#include "sim_os.h"
+#include "trace.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_OS_THREAD_NAME_LEN      (16U)   /* Including the terminator - pthread_setname_np limit */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+struct os_thread_cb
+{
+    pthread_t thread;
+    os_pthread pthread;
+    void* argument;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t signals;
+    bool pending;                       /* Notification pending - cleared by osSignalWait */
+    char name[SIM_OS_THREAD_NAME_LEN];
+    uint32_t number;                    /* Creation order - FreeRTOS xTaskNumber */
+    uint32_t priority;
+    uint32_t stack;                     /* Stack size of the definition in words */
+    struct os_thread_cb* next;          /* Created threads - uxTaskGetSystemState */
+};
+
+struct os_semaphore_cb
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int32_t count;
+    int32_t max;
+};
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void* Sim_Os_ThreadEntry(void* arg);
+static uint64_t Sim_Os_TimeoutToNs(uint32_t millisec);
+static void Sim_Os_SetPriority(pthread_t thread, int priority);
+static void Sim_Os_TaskBlock(void);
+static void Sim_Os_TaskResume(void);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+static struct timespec Sim_Os_StartTime;
+static pthread_mutex_t Sim_Os_Critical;
+static pthread_mutex_t Sim_Os_KernelMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Sim_Os_KernelCond;
+static bool Sim_Os_KernelRunning;
+static __thread struct os_thread_cb* Sim_Os_Self;
+static struct os_thread_cb* Sim_Os_Threads;
+static atomic_uint Sim_Os_ThreadNumber;
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulation kernel initialization function - should be called before any other function
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Os_Init(void)
+{
+    pthread_mutexattr_t attr;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &Sim_Os_StartTime);
+
+    /* Default 50 us timer slack would stretch every simulated transfer - inherited by all threads */
+    (void)prctl(PR_SET_TIMERSLACK, 1UL);
+
+    /* Nested critical sections, a task holding it inherits the priority of a waiting interrupt */
+    (void)pthread_mutexattr_init(&attr);
+    (void)pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    (void)pthread_mutexattr_setprotocol(&attr, PTHREAD_PRIO_INHERIT);
+    (void)pthread_mutex_init(&Sim_Os_Critical, &attr);
+    (void)pthread_mutexattr_destroy(&attr);
+
+    Sim_Os_CondInit(&Sim_Os_KernelCond);
+}
+
+/*!
+ * \brief Get time since Sim_Os_Init
+ *
+ * \param[in] None
+ *
+ * \retval Time in ns
+ */
+uint64_t Sim_Os_GetTimeNs(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)(now.tv_sec - Sim_Os_StartTime.tv_sec) * SIM_OS_NS_IN_S) +
+           (uint64_t)now.tv_nsec - (uint64_t)Sim_Os_StartTime.tv_nsec;
+}
+
+/*!
+ * \brief Sleep until the absolute time, returns immediately if the time has passed
+ *
+ * \param[in] time Time since Sim_Os_Init in ns
+ *
+ * \retval None
+ */
+void Sim_Os_SleepUntil(uint64_t time)
+{
+    uint64_t abs_time = ((uint64_t)Sim_Os_StartTime.tv_sec * SIM_OS_NS_IN_S) + (uint64_t)Sim_Os_StartTime.tv_nsec + time;
+    struct timespec ts = {.tv_sec = (time_t)(abs_time / SIM_OS_NS_IN_S), .tv_nsec = (long)(abs_time % SIM_OS_NS_IN_S)};
+
+    while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+    {
+        /* Interrupted by a signal - sleep again */
+    }
+}
+
+/*!
+ * \brief Create thread of a simulated peripheral - its callbacks run as an interrupt
+ *
+ * \param[in] name Thread name
+ * \param[in] function Thread function
+ * \param[in] nvic_priority NVIC preemption priority of the simulated interrupt
+ *
+ * \retval true - created, false - error
+ */
+bool Sim_Os_CreateIrqThread(const char* name, void* (*function)(void*), uint32_t nvic_priority)
+{
+    pthread_t thread;
+
+    if(pthread_create(&thread, NULL, function, NULL) != 0)
+    {
+        return false;
+    }
+
+    (void)pthread_setname_np(thread, name);
+    Sim_Os_SetPriority(thread, SIM_OS_IRQ_PRIORITY - (int)nvic_priority);
+    (void)pthread_detach(thread);
+
+    return true;
+}
+
+/*!
+ * \brief Interrupt entry of a simulated peripheral - waits while a task is in a critical section
+ *        or another interrupt runs
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Os_IrqEnter(void)
+{
+    (void)pthread_mutex_lock(&Sim_Os_Critical);
+}
+
+/*!
+ * \brief Interrupt exit of a simulated peripheral
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Os_IrqExit(void)
+{
+    (void)pthread_mutex_unlock(&Sim_Os_Critical);
+}
+
+/*!
+ * \brief Initialize condition variable on the monotonic clock
+ *
+ * \param[in] cond Condition variable
+ *
+ * \retval None
+ */
+void Sim_Os_CondInit(pthread_cond_t* cond)
+{
+    pthread_condattr_t attr;
+
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(cond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+}
+
+/*!
+ * \brief Wait for condition variable until the absolute time
+ *
+ * \param[in] cond Condition variable initialized by Sim_Os_CondInit
+ * \param[in] mutex Locked mutex
+ * \param[in] time Time since Sim_Os_Init in ns, UINT64_MAX waits forever
+ *
+ * \retval true - signaled (or spurious wake-up), false - timeout
+ */
+bool Sim_Os_CondWaitUntil(pthread_cond_t* cond, pthread_mutex_t* mutex, uint64_t time)
+{
+    uint64_t abs_time;
+    struct timespec ts;
+
+    if(time == UINT64_MAX)
+    {
+        return (pthread_cond_wait(cond, mutex) == 0);
+    }
+
+    abs_time = ((uint64_t)Sim_Os_StartTime.tv_sec * SIM_OS_NS_IN_S) + (uint64_t)Sim_Os_StartTime.tv_nsec + time;
+    ts.tv_sec = (time_t)(abs_time / SIM_OS_NS_IN_S);
+    ts.tv_nsec = (long)(abs_time % SIM_OS_NS_IN_S);
+
+    return (pthread_cond_timedwait(cond, mutex, &ts) == 0);
+}
+
+/*!
+ * \brief FreeRTOS critical section entry
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Os_EnterCritical(void)
+{
+    (void)pthread_mutex_lock(&Sim_Os_Critical);
+}
+
+/*!
+ * \brief FreeRTOS critical section exit
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Os_ExitCritical(void)
+{
+    (void)pthread_mutex_unlock(&Sim_Os_Critical);
+}
+
+/*!
+ * \brief Start the kernel - releases the created threads, never returns
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+osStatus osKernelStart(void)
+{
+    (void)pthread_mutex_lock(&Sim_Os_KernelMutex);
+    Sim_Os_KernelRunning = true;
+    (void)pthread_cond_broadcast(&Sim_Os_KernelCond);
+    (void)pthread_mutex_unlock(&Sim_Os_KernelMutex);
+
+    for(;;)
+    {
+        (void)pause();
+    }
+
+    return osOK;
+}
+
+/*!
+ * \brief Get kernel tick count - 1 ms tick
+ *
+ * \param[in] None
+ *
+ * \retval Ticks since Sim_Os_Init
+ */
+uint32_t osKernelSysTick(void)
+{
+    return (uint32_t)(Sim_Os_GetTimeNs() / SIM_OS_NS_IN_MS);
+}
+
+/*!
+ * \brief Create thread - the thread starts running after osKernelStart
+ *
+ * \param[in] thread_def Thread definition
+ * \param[in] argument Thread function argument
+ *
+ * \retval Thread ID, NULL on error
+ */
+osThreadId osThreadCreate(const osThreadDef_t* thread_def, void* argument)
+{
+    struct os_thread_cb* cb = calloc(1U, sizeof(struct os_thread_cb));
+
+    if(cb == NULL)
+    {
+        return NULL;
+    }
+
+    /* The definition may be a local object of the caller */
+    cb->pthread = thread_def->pthread;
+    cb->argument = argument;
+    (void)strncpy(cb->name, thread_def->name, sizeof(cb->name) - 1U);
+    cb->priority = (uint32_t)(thread_def->tpriority - osPriorityIdle);
+    cb->stack = thread_def->stacksize;
+    cb->number = atomic_fetch_add(&Sim_Os_ThreadNumber, 1U) + 1U;     /* Before the thread can trace */
+    (void)pthread_mutex_init(&cb->mutex, NULL);
+    Sim_Os_CondInit(&cb->cond);
+
+    if(pthread_create(&cb->thread, NULL, Sim_Os_ThreadEntry, cb) != 0)
+    {
+        free(cb);
+        return NULL;
+    }
+
+    /* Thread names are visible to perf, gdb and top */
+    (void)pthread_setname_np(cb->thread, cb->name);
+    Sim_Os_SetPriority(cb->thread, SIM_OS_TASK_PRIORITY + (int)thread_def->tpriority);
+
+    (void)pthread_mutex_lock(&Sim_Os_KernelMutex);
+    cb->next = Sim_Os_Threads;
+    Sim_Os_Threads = cb;
+    (void)pthread_mutex_unlock(&Sim_Os_KernelMutex);
+
+    return cb;
+}
+
+/*!
+ * \brief Get the state of the threads - run time counters in us of host CPU time against the elapsed
+ *        time, the stack is not measured (the size of the definition is reported) and there is no
+ *        idle task, so the headroom is the remainder to 100 %
+ *
+ * \param[out] pxTaskStatusArray States of the threads
+ * \param[in] uxArraySize Size of the array
+ * \param[out] pulTotalRunTime Elapsed time in us, may be NULL
+ *
+ * \retval Number of threads written, 0 if the array is too small
+ */
+UBaseType_t uxTaskGetSystemState(TaskStatus_t* const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t* const pulTotalRunTime)
+{
+    UBaseType_t num = 0U;
+
+    (void)pthread_mutex_lock(&Sim_Os_KernelMutex);
+
+    if(atomic_load(&Sim_Os_ThreadNumber) <= uxArraySize)
+    {
+        for(struct os_thread_cb* cb = Sim_Os_Threads; cb != NULL; cb = cb->next)
+        {
+            TaskStatus_t* status = &pxTaskStatusArray[num++];
+            struct timespec time = { 0 };
+            clockid_t clock;
+
+            if(pthread_getcpuclockid(cb->thread, &clock) == 0)
+            {
+                (void)clock_gettime(clock, &time);
+            }
+
+            status->xHandle = cb;
+            status->pcTaskName = cb->name;
+            status->xTaskNumber = cb->number;
+            status->uxCurrentPriority = cb->priority;
+            status->ulRunTimeCounter = (uint32_t)(((uint64_t)time.tv_sec * 1000000ULL) + ((uint64_t)time.tv_nsec / 1000ULL));
+            status->usStackHighWaterMark = (uint16_t)cb->stack;
+        }
+    }
+
+    (void)pthread_mutex_unlock(&Sim_Os_KernelMutex);
+
+    if(pulTotalRunTime != NULL)
+    {
+        *pulTotalRunTime = (uint32_t)(Sim_Os_GetTimeNs() / 1000ULL);
+    }
+
+    return num;
+}
+
+/*!
+ * \brief Delay the calling thread
+ *
+ * \param[in] millisec Delay in ms
+ *
+ * \retval osOK
+ */
+osStatus osDelay(uint32_t millisec)
+{
+    Sim_Os_TaskBlock();
+    Sim_Os_SleepUntil(Sim_Os_GetTimeNs() + ((uint64_t)millisec * SIM_OS_NS_IN_MS));
+    Sim_Os_TaskResume();
+
+    return osOK;
+}
+
+/*!
+ * \brief Delay the calling thread until the previous wake time plus period
+ *
+ * \param[in] PreviousWakeTime Previous wake time in ticks - updated
+ * \param[in] millisec Period in ms
+ *
+ * \retval osOK
+ */
+osStatus osDelayUntil(uint32_t* PreviousWakeTime, uint32_t millisec)
+{
+    *PreviousWakeTime += millisec;
+    Sim_Os_TaskBlock();
+    Sim_Os_SleepUntil((uint64_t)*PreviousWakeTime * SIM_OS_NS_IN_MS);
+    Sim_Os_TaskResume();
+
+    return osOK;
+}
+
+/*!
+ * \brief Set signal flags of the thread - can be called from tasks and simulated interrupts
+ *
+ * \param[in] thread_id Thread ID
+ * \param[in] signals Signal flags
+ *
+ * \retval Previous signal flags, 0x80000000 on error
+ */
+int32_t osSignalSet(osThreadId thread_id, int32_t signals)
+{
+    int32_t ret_val;
+
+    if(thread_id == NULL)
+    {
+        return (int32_t)0x80000000U;
+    }
+
+    (void)pthread_mutex_lock(&thread_id->mutex);
+    ret_val = (int32_t)thread_id->signals;
+    thread_id->signals |= (uint32_t)signals;
+    thread_id->pending = true;
+    (void)pthread_cond_signal(&thread_id->cond);
+    (void)pthread_mutex_unlock(&thread_id->mutex);
+
+    return ret_val;
+}
+
+/*!
+ * \brief Wait for signal flags of the calling thread - the waited flags are cleared on exit
+ *        (same as xTaskNotifyWait in the FreeRTOS CMSIS-RTOS layer)
+ *
+ * \param[in] signals Signal flags to clear
+ * \param[in] millisec Timeout in ms, 0 - no wait, osWaitForever - no timeout
+ *
+ * \retval Event - osEventSignal, osEventTimeout or osOK when nothing was pending and millisec is 0
+ */
+osEvent osSignalWait(int32_t signals, uint32_t millisec)
+{
+    struct os_thread_cb* self = Sim_Os_Self;
+    uint64_t timeout = Sim_Os_TimeoutToNs(millisec);
+    osEvent event = {.status = osErrorOS};
+    bool blocked;
+
+    if(self == NULL)
+    {
+        return event;
+    }
+
+    (void)pthread_mutex_lock(&self->mutex);
+
+    blocked = (self->pending == false) && (millisec != 0U);
+    if(blocked)
+    {
+        Sim_Os_TaskBlock();
+    }
+
+    while((self->pending == false) && (millisec != 0U))
+    {
+        if(Sim_Os_CondWaitUntil(&self->cond, &self->mutex, timeout) == false)
+        {
+            break;
+        }
+    }
+
+    if(blocked)
+    {
+        Sim_Os_TaskResume();
+    }
+
+    if(self->pending == true)
+    {
+        event.status = osEventSignal;
+        event.value.signals = (int32_t)self->signals;
+        self->signals &= ~(uint32_t)signals;
+        self->pending = false;
+    }
+    else
+    {
+        event.status = (millisec == 0U) ? osOK : osEventTimeout;
+    }
+
+    (void)pthread_mutex_unlock(&self->mutex);
+
+    return event;
+}
+
+/*!
+ * \brief Create semaphore - count 1 creates an available binary semaphore
+ *
+ * \param[in] semaphore_def Semaphore definition
+ * \param[in] count Maximum and initial count
+ *
+ * \retval Semaphore ID, NULL on error
+ */
+osSemaphoreId osSemaphoreCreate(const osSemaphoreDef_t* semaphore_def, int32_t count)
+{
+    struct os_semaphore_cb* cb = calloc(1U, sizeof(struct os_semaphore_cb));
+
+    if(cb != NULL)
+    {
+        (void)pthread_mutex_init(&cb->mutex, NULL);
+        Sim_Os_CondInit(&cb->cond);
+        cb->count = count;
+        cb->max = count;
+    }
+
+    return cb;
+}
+
+/*!
+ * \brief Take semaphore
+ *
+ * \param[in] semaphore_id Semaphore ID
+ * \param[in] millisec Timeout in ms, 0 - no wait, osWaitForever - no timeout
+ *
+ * \retval osOK - taken, osErrorOS - timeout
+ */
+int32_t osSemaphoreWait(osSemaphoreId semaphore_id, uint32_t millisec)
+{
+    uint64_t timeout = Sim_Os_TimeoutToNs(millisec);
+    int32_t ret_val = osErrorOS;
+    bool blocked;
+
+    if(semaphore_id == NULL)
+    {
+        return osErrorParameter;
+    }
+
+    (void)pthread_mutex_lock(&semaphore_id->mutex);
+
+    blocked = (semaphore_id->count == 0) && (millisec != 0U);
+    if(blocked)
+    {
+        Sim_Os_TaskBlock();
+    }
+
+    while((semaphore_id->count == 0) && (millisec != 0U))
+    {
+        if(Sim_Os_CondWaitUntil(&semaphore_id->cond, &semaphore_id->mutex, timeout) == false)
+        {
+            break;
+        }
+    }
+
+    if(blocked)
+    {
+        Sim_Os_TaskResume();
+    }
+
+    if(semaphore_id->count > 0)
+    {
+        semaphore_id->count--;
+        ret_val = osOK;
+    }
+
+    (void)pthread_mutex_unlock(&semaphore_id->mutex);
+
+    return ret_val;
+}
+
+/*!
+ * \brief Give semaphore - can be called from tasks and simulated interrupts
+ *
+ * \param[in] semaphore_id Semaphore ID
+ *
+ * \retval osOK - given, osErrorOS - already at the maximum count
+ */
+osStatus osSemaphoreRelease(osSemaphoreId semaphore_id)
+{
+    osStatus ret_val = osErrorOS;
+
+    if(semaphore_id == NULL)
+    {
+        return osErrorParameter;
+    }
+
+    (void)pthread_mutex_lock(&semaphore_id->mutex);
+
+    if(semaphore_id->count < semaphore_id->max)
+    {
+        semaphore_id->count++;
+        (void)pthread_cond_signal(&semaphore_id->cond);
+        ret_val = osOK;
+    }
+
+    (void)pthread_mutex_unlock(&semaphore_id->mutex);
+
+    return ret_val;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Thread entry - waits for osKernelStart and runs the thread function
+ *
+ * \param[in] arg Thread control block
+ *
+ * \retval NULL
+ */
+static void* Sim_Os_ThreadEntry(void* arg)
+{
+    struct os_thread_cb* cb = arg;
+
+    Sim_Os_Self = cb;
+
+    (void)pthread_mutex_lock(&Sim_Os_KernelMutex);
+
+    while(Sim_Os_KernelRunning == false)
+    {
+        (void)pthread_cond_wait(&Sim_Os_KernelCond, &Sim_Os_KernelMutex);
+    }
+
+    (void)pthread_mutex_unlock(&Sim_Os_KernelMutex);
+
+    Sim_Os_TaskResume();
+    cb->pthread(cb->argument);
+
+    return NULL;
+}
+
+/*!
+ * \brief Convert CMSIS-RTOS timeout into the absolute time
+ *
+ * \param[in] millisec Timeout in ms, osWaitForever - no timeout
+ *
+ * \retval Time since Sim_Os_Init in ns, UINT64_MAX for no timeout
+ */
+static uint64_t Sim_Os_TimeoutToNs(uint32_t millisec)
+{
+    if(millisec == osWaitForever)
+    {
+        return UINT64_MAX;
+    }
+
+    return Sim_Os_GetTimeNs() + ((uint64_t)millisec * SIM_OS_NS_IN_MS);
+}
+
+/*!
+ * \brief Set real-time priority of the thread - ignored without the permission
+ *
+ * \param[in] thread Thread
+ * \param[in] priority SCHED_FIFO priority
+ *
+ * \retval None
+ */
+static void Sim_Os_SetPriority(pthread_t thread, int priority)
+{
+    struct sched_param param = {.sched_priority = priority};
+
+    (void)pthread_setschedparam(thread, SCHED_FIFO, &param);
+}
+
+/*!
+ * \brief Trace the calling task as switched out before it blocks - the host threads run concurrently,
+ *        so a task is traced as running whenever it is not waiting in the kernel
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+static void Sim_Os_TaskBlock(void)
+{
+    if(Sim_Os_Self != NULL)
+    {
+        TRACE_TASK_SWITCHED_OUT(Sim_Os_Self->number);
+    }
+}
+
+/*!
+ * \brief Trace the calling task as switched in after it was woken up
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+static void Sim_Os_TaskResume(void)
+{
+    if(Sim_Os_Self != NULL)
+    {
+        TRACE_TASK_SWITCHED_IN(Sim_Os_Self->number);
+    }
+}
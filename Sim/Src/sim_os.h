@@ -0,0 +1,56 @@
+#ifndef _SIM_OS_H_
+#define _SIM_OS_H_
+
+/*
+ * Host simulation kernel services - time base and the interrupt lock of the simulated peripherals.
+ * The CMSIS-RTOS API itself is declared in cmsis_os.h.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_OS_NS_IN_MS         (1000000ULL)
+#define SIM_OS_NS_IN_S          (1000000000ULL)
+
+/*
+ * SCHED_FIFO priorities - tasks at SIM_OS_TASK_PRIORITY + osPriority, simulated interrupts above all
+ * tasks in NVIC order. Without the permission (root or CAP_SYS_NICE) the threads keep the default
+ * scheduling and run concurrently.
+ */
+#define SIM_OS_TASK_PRIORITY    (10)
+#define SIM_OS_IRQ_PRIORITY     (40)    /* Minus the NVIC preemption priority */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Exported objects ********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_Os_Init(void);
+uint64_t Sim_Os_GetTimeNs(void);
+void Sim_Os_SleepUntil(uint64_t time);
+bool Sim_Os_CreateIrqThread(const char* name, void* (*function)(void*), uint32_t nvic_priority);
+void Sim_Os_IrqEnter(void);
+void Sim_Os_IrqExit(void);
+void Sim_Os_CondInit(pthread_cond_t* cond);
+bool Sim_Os_CondWaitUntil(pthread_cond_t* cond, pthread_mutex_t* mutex, uint64_t time);
+
+#endif  /* _SIM_OS_H_ */
@@ -0,0 +1,484 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdbool.h>
+#include <pthread.h>
+#include "ina226.h"
+#include "hal_energy_monitor.h"
+#include "hal_energy_monitor_cfg.h"
+#include "app_telemetry.h"
+#include "sim_report.h"
+#include "sim_ina226.h"
+#include "sim_i2c.h"
+#include "sim_waveform.h"
+#include "sim_os.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_REPORT_POLL_PERIOD          (SIM_OS_NS_IN_MS)   /* ns - sample history read period */
+#define SIM_REPORT_BATCH_LEN            (16U)               /* Samples read from the history at once */
+#define SIM_REPORT_NS_IN_US             (1000ULL)
+
+/*
+ * Modeled I2C1 interrupts of the STM32F7 HAL (automatic end mode): interrupt transfers take one TXIS/RXNE
+ * interrupt per data byte and the STOPF interrupt, DMA transfers the DMA transfer complete and the STOPF interrupt
+ */
+#define SIM_REPORT_IT_IRQS_PER_TRANSFER     (1U)    /* Plus one per byte */
+#define SIM_REPORT_DMA_IRQS_PER_TRANSFER    (2U)
+
+/*
+ * Accumulation projected over a long uptime: the integer accumulator of the HAL (nWh with the pJ rest carried)
+ * against the float mWh accumulator the application used before
+ */
+#define SIM_REPORT_DRIFT_DAYS           (30U)
+#define SIM_REPORT_S_IN_DAY             (86400ULL)
+#define SIM_REPORT_PJ_IN_NWH            (3600000LL)     /* uW * us = pJ */
+
+/* Text log line of one sample - same layout as the line of App_EnergyMonitor_TransmitLog */
+#define SIM_REPORT_TEXT_LINE_LEN        (256U)
+
+/* Units of Sim_Waveform_Integral_t to the HAL units */
+#define SIM_REPORT_UW_NS_IN_NWH         (3.6e15)
+#define SIM_REPORT_UA_NS_IN_NAH         (3.6e9)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef struct
+{
+    Hal_EnergyMonitor_Energy_t energy;      /* Accumulated at the first sample */
+    uint64_t first;                         /* ns - acquisition time of the first sample */
+    uint64_t last;                          /* ns - acquisition time of the last sample */
+    uint32_t samples;                       /* Samples delivered by the HAL */
+    bool started;
+}Sim_Report_Channel_t;
+
+/* Log size of the samples read from the history in every format */
+typedef struct
+{
+    uint64_t text;                          /* Bytes of the text lines */
+    uint64_t record;                        /* Bytes of the record frames */
+    uint64_t stream;                        /* Bytes of the closed stream block frames */
+    uint32_t samples;                       /* Samples encoded as text and records */
+    uint32_t stream_samples;                /* Samples in the closed stream blocks */
+    uint32_t block_samples;                 /* Samples in the open stream block */
+}Sim_Report_Telemetry_t;
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void* Sim_Report_Thread(void* arg);
+static double Sim_Report_PrintChannel(FILE* stream, uint8_t channel);
+static void Sim_Report_PrintI2c(FILE* stream);
+static void Sim_Report_Encode(const Hal_EnergyMonitor_Sample_t* sample);
+static void Sim_Report_PrintTelemetry(FILE* stream);
+static void Sim_Report_PrintDrift(FILE* stream, uint8_t channel);
+static void Sim_Report_PrintError(FILE* stream, const char* name, const char* unit, double measured, double expected);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/* I2C address of every HAL channel */
+static const uint8_t Sim_Report_Address[HAL_ENERGY_MONITOR_CHANNELS_NUM] =
+{
+    #define INA226_CFG_DEVICE(name, addr, cal, mask, limit)   [name] = (addr),
+        INA226_CFG_DEVICE_TABLE
+    #undef INA226_CFG_DEVICE
+};
+
+static Sim_Report_Channel_t Sim_Report_Channels[HAL_ENERGY_MONITOR_CHANNELS_NUM];
+static Hal_EnergyMonitor_Sample_t Sim_Report_Batch[SIM_REPORT_BATCH_LEN];
+static Sim_I2c_Stats_t Sim_Report_I2cFirst;        /* Transfers at the first sample - start-up excluded */
+static uint32_t Sim_Report_Samples;                 /* Samples of all channels after the first one */
+static bool Sim_Report_Started;
+static Sim_Report_Telemetry_t Sim_Report_Telemetry;
+static App_Telemetry_Stream_t Sim_Report_Stream;
+static uint8_t Sim_Report_Frame[APP_TELEMETRY_BLOCK_FRAME_MAX_LEN];
+static pthread_mutex_t Sim_Report_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Start the report - records the first sample of every channel as it arrives
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Report_Init(void)
+{
+    pthread_t thread;
+
+    App_Telemetry_StreamBegin(&Sim_Report_Stream);
+
+    (void)pthread_create(&thread, NULL, Sim_Report_Thread, NULL);
+    (void)pthread_detach(thread);
+}
+
+/*!
+ * \brief Print the report of the simulation so far
+ *
+ * \param[in] stream Output stream - stdout carries the UART stream
+ *
+ * \retval None
+ */
+void Sim_Report_Print(FILE* stream)
+{
+    double rate = 0.0;
+
+#if (HAL_ENERGY_MONITOR_CNVR_MODE == 1U)
+    (void)fprintf(stream, "Acquisition: conversion ready (ALERT), timeout %u ms\n", HAL_ENERGY_MONITOR_CNVR_TIMEOUT);
+#else
+    (void)fprintf(stream, "Acquisition: polling every %u us\n", (unsigned int)Hal_EnergyMonitor_GetPeriod());
+#endif
+
+    for(uint8_t i = 0U; i < HAL_ENERGY_MONITOR_CHANNELS_NUM; i++)
+    {
+        rate += Sim_Report_PrintChannel(stream, i);
+    }
+
+    (void)fprintf(stream, "Throughput: %.2f samples/s, %u channels on one bus\n", rate, (unsigned int)HAL_ENERGY_MONITOR_CHANNELS_NUM);
+
+    Sim_Report_PrintTelemetry(stream);
+    Sim_Report_PrintI2c(stream);
+    Sim_Report_PrintDrift(stream, 0U);
+
+    (void)fflush(stream);
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Follow the sample history of the HAL - first sample and number of samples of every channel
+ *
+ * \param[in] arg Not used
+ *
+ * \retval None
+ */
+static void* Sim_Report_Thread(void* arg)
+{
+    Sim_Report_Channel_t* channel;
+    uint32_t cursor = 0U;
+    uint32_t num;
+
+    for(;;)
+    {
+        Sim_Os_SleepUntil(Sim_Os_GetTimeNs() + SIM_REPORT_POLL_PERIOD);
+
+        do
+        {
+            num = Hal_EnergyMonitor_ReadBatch(Sim_Report_Batch, SIM_REPORT_BATCH_LEN, &cursor);
+
+            (void)pthread_mutex_lock(&Sim_Report_Mutex);
+
+            for(uint32_t i = 0U; i < num; i++)
+            {
+                channel = &Sim_Report_Channels[Sim_Report_Batch[i].channel];
+
+                if(Sim_Report_Started == false)
+                {
+                    Sim_I2c_GetStats(&Sim_Report_I2cFirst);
+                    Sim_Report_Started = true;
+                }
+                else
+                {
+                    Sim_Report_Samples++;
+                }
+
+                if(channel->started == false)
+                {
+                    Hal_EnergyMonitor_GetEnergy(Sim_Report_Batch[i].channel, &channel->energy);
+                    channel->first = Sim_Report_Batch[i].timestamp;
+                    channel->started = true;
+                }
+
+                channel->last = Sim_Report_Batch[i].timestamp;
+                channel->samples++;
+
+                Sim_Report_Encode(&Sim_Report_Batch[i]);
+            }
+
+            (void)pthread_mutex_unlock(&Sim_Report_Mutex);
+        } while(num == SIM_REPORT_BATCH_LEN);
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Print the report of one channel
+ *
+ * \param[in] stream Output stream
+ * \param[in] channel HAL channel
+ *
+ * \retval Samples per second, 0 if the channel delivered no samples
+ */
+static double Sim_Report_PrintChannel(FILE* stream, uint8_t channel)
+{
+    uint8_t address = Sim_Report_Address[channel];
+    const Sim_Waveform_t* waveform = Sim_Ina226_GetWaveform(address);
+    Sim_Waveform_Integral_t integral;
+    Sim_Report_Channel_t first;
+    Hal_EnergyMonitor_Energy_t energy;
+    uint64_t shunt_time = 0U;
+    uint64_t bus_time = 0U;
+    uint32_t averages = 0U;
+    uint64_t conversion;
+    double interval;
+    double rate;
+
+    (void)fprintf(stream, "Channel %u (0x%02X)\n", channel, address);
+
+    if((waveform == NULL) || (Sim_Ina226_GetTiming(address, &shunt_time, &bus_time, &averages) == false))
+    {
+        (void)fprintf(stream, "  No simulated device\n");
+        return 0.0;
+    }
+
+    conversion = (shunt_time + bus_time) * averages;
+    (void)fprintf(stream, "  INA226: shunt %llu us, bus %llu us, %u averages - %.3f ms per result (%.2f /s)\n",
+                  (unsigned long long)(shunt_time / SIM_REPORT_NS_IN_US), (unsigned long long)(bus_time / SIM_REPORT_NS_IN_US),
+                  (unsigned int)averages, (double)conversion / SIM_OS_NS_IN_MS,
+                  (conversion != 0U) ? ((double)SIM_OS_NS_IN_S / conversion) : 0.0);
+
+    (void)pthread_mutex_lock(&Sim_Report_Mutex);
+    first = Sim_Report_Channels[channel];
+    (void)pthread_mutex_unlock(&Sim_Report_Mutex);
+
+    Hal_EnergyMonitor_GetEnergy(channel, &energy);
+
+    if(first.started == true)
+    {
+        (void)fprintf(stream, "  First sample: %.3f ms after start-up\n", (double)first.first / SIM_OS_NS_IN_MS);
+    }
+
+    if((first.started == false) || (first.samples < 2U) || (energy.timestamp <= first.energy.timestamp))
+    {
+        (void)fprintf(stream, "  Not enough samples\n");
+        return 0.0;
+    }
+
+    interval = (double)(first.last - first.first) / SIM_OS_NS_IN_S;
+    rate = (double)(first.samples - 1U) / interval;
+    (void)fprintf(stream, "  Samples: %u in %.3f s - %.2f /s\n", (unsigned int)first.samples, interval, rate);
+
+    /* Same interval as the HAL integrator - from the first to the last integrated sample */
+    Sim_Waveform_Integrate(waveform, first.energy.timestamp, energy.timestamp, &integral);
+
+    Sim_Report_PrintError(stream, "Energy", "nWh", (double)(energy.energy - first.energy.energy), integral.power / SIM_REPORT_UW_NS_IN_NWH);
+    Sim_Report_PrintError(stream, "Charge", "nAh", (double)(energy.charge - first.energy.charge), integral.current / SIM_REPORT_UA_NS_IN_NAH);
+
+    return rate;
+}
+
+/*!
+ * \brief Encode the sample in every log format and count the bytes - called with the report mutex locked
+ *
+ * \param[in] sample Sample read from the history
+ *
+ * \retval None
+ */
+static void Sim_Report_Encode(const Hal_EnergyMonitor_Sample_t* sample)
+{
+    Sim_Report_Telemetry_t* telemetry = &Sim_Report_Telemetry;
+    Hal_EnergyMonitor_Energy_t energy;
+    char line[SIM_REPORT_TEXT_LINE_LEN];
+    uint32_t time_us = (uint32_t)(sample->timestamp / SIM_REPORT_NS_IN_US);
+    int len;
+
+    Hal_EnergyMonitor_GetEnergy(sample->channel, &energy);
+
+    len = snprintf(line, sizeof(line), "%02u::%02u::%02u.%06u CH%u U= %.2f[V] I=%.2f (%.2f..%.2f, RMS %.2f) [mA] "
+                   "P=%.2f (max %.2f) [mW] Consumption=%.2f [mWh] Charge=%.3f [mAh] Lost:0 Alert:0\r\n",
+                   (unsigned int)(time_us / 3600000000U), (unsigned int)((time_us / 60000000U) % 60U),
+                   (unsigned int)((time_us / 1000000U) % 60U), (unsigned int)(time_us % 1000000U), sample->channel,
+                   sample->bus_voltage / 1e6, sample->current / 1e3, sample->current / 1e3, sample->current / 1e3,
+                   sample->current / 1e3, sample->power / 1e3, sample->power / 1e3, energy.energy / 1e6, energy.charge / 1e6);
+
+    telemetry->text += (uint64_t)((len > 0) ? len : 0);
+    telemetry->record += App_Telemetry_EncodeSample(Sim_Report_Frame, sample, (uint16_t)telemetry->samples, false);
+    telemetry->samples++;
+
+    if(!App_Telemetry_StreamAdd(&Sim_Report_Stream, sample, 0U, false))
+    {
+        telemetry->stream += App_Telemetry_StreamEnd(&Sim_Report_Stream, Sim_Report_Frame);
+        telemetry->stream_samples += telemetry->block_samples;
+        telemetry->block_samples = 0U;
+
+        App_Telemetry_StreamBegin(&Sim_Report_Stream);
+        (void)App_Telemetry_StreamAdd(&Sim_Report_Stream, sample, 0U, false);
+    }
+
+    telemetry->block_samples++;
+}
+
+/*!
+ * \brief Print the log bytes per sample of the text, record and stream formats - the samples read from
+ *        the history encoded in every format, framing included (leading delimiters of the writes excluded)
+ *
+ * \param[in] stream Output stream
+ *
+ * \retval None
+ */
+static void Sim_Report_PrintTelemetry(FILE* stream)
+{
+    Sim_Report_Telemetry_t telemetry;
+    double text;
+    double record;
+    double block;
+
+    (void)pthread_mutex_lock(&Sim_Report_Mutex);
+    telemetry = Sim_Report_Telemetry;
+    (void)pthread_mutex_unlock(&Sim_Report_Mutex);
+
+    if(telemetry.stream_samples == 0U)
+    {
+        (void)fprintf(stream, "Log per sample: not enough samples for a stream block\n");
+        return;
+    }
+
+    text = (double)telemetry.text / telemetry.samples;
+    record = (double)telemetry.record / telemetry.samples;
+    block = (double)telemetry.stream / telemetry.stream_samples;
+
+    (void)fprintf(stream, "Log per sample: text %.2f bytes, record %.2f bytes, stream %.2f bytes - stream %.1f %% of record, "
+                  "%.1f %% of text\n", text, record, block, (block * 100.0) / record, (block * 100.0) / text);
+}
+
+/*!
+ * \brief Print the I2C transfers and the modeled interrupts per sample set (bus, current and power of one channel)
+ *
+ * \param[in] stream Output stream
+ *
+ * \retval None
+ */
+static void Sim_Report_PrintI2c(FILE* stream)
+{
+    Sim_I2c_Stats_t first;
+    Sim_I2c_Stats_t last;
+    uint32_t samples;
+    double transfers;
+    double bytes;
+
+    Sim_I2c_GetStats(&last);
+
+    (void)pthread_mutex_lock(&Sim_Report_Mutex);
+    first = Sim_Report_I2cFirst;
+    samples = Sim_Report_Samples;
+    (void)pthread_mutex_unlock(&Sim_Report_Mutex);
+
+    (void)fprintf(stream, "I2C aborts: %u\n", (unsigned int)last.aborts);
+
+    if(samples == 0U)
+    {
+        return;
+    }
+
+    transfers = (double)((last.it_transfers - first.it_transfers) + (last.dma_transfers - first.dma_transfers)) / samples;
+    bytes = (double)(last.bytes - first.bytes) / samples;
+
+    (void)fprintf(stream, "I2C per sample set: %.2f transfers, %.2f bytes (%s)\n", transfers, bytes,
+                  (last.dma_transfers != 0U) ? "DMA" : "interrupt");
+    (void)fprintf(stream, "Interrupts per sample set: interrupt transfers %.2f, DMA transfers %.2f\n",
+                  bytes + (transfers * SIM_REPORT_IT_IRQS_PER_TRANSFER), transfers * SIM_REPORT_DMA_IRQS_PER_TRANSFER);
+}
+
+/*!
+ * \brief Print the error of the energy accumulated over SIM_REPORT_DRIFT_DAYS - the last power of the channel
+ *        at its mean sample interval, added once per sample as integer nWh (rest carried, as the HAL does)
+ *        and as float mWh (as the application did before the integer units)
+ *
+ * \param[in] stream Output stream
+ * \param[in] channel HAL channel
+ *
+ * \retval None
+ */
+static void Sim_Report_PrintDrift(FILE* stream, uint8_t channel)
+{
+    Sim_Report_Channel_t first;
+    Hal_EnergyMonitor_Data_t data;
+    uint64_t interval;      /* us */
+    uint64_t steps;
+    int64_t energy = 0;     /* nWh */
+    int64_t rest = 0;       /* pJ */
+    float energy_float = 0.0f;  /* mWh */
+    float power_float;      /* mW */
+    float interval_float;   /* s */
+    double exact;           /* nWh */
+
+    (void)pthread_mutex_lock(&Sim_Report_Mutex);
+    first = Sim_Report_Channels[channel];
+    (void)pthread_mutex_unlock(&Sim_Report_Mutex);
+
+    if(first.samples < 2U)
+    {
+        return;
+    }
+
+    Hal_EnergyMonitor_GetResults(channel, &data);
+    interval = (first.last - first.first) / ((uint64_t)(first.samples - 1U) * SIM_REPORT_NS_IN_US);
+
+    if(interval == 0U)
+    {
+        return;
+    }
+
+    steps = (SIM_REPORT_DRIFT_DAYS * SIM_REPORT_S_IN_DAY * (SIM_OS_NS_IN_S / SIM_REPORT_NS_IN_US)) / interval;
+    power_float = (float)data.power / 1000.0f;
+    interval_float = (float)interval / 1000000.0f;
+
+    for(uint64_t i = 0U; i < steps; i++)
+    {
+        rest += (int64_t)data.power * (int64_t)interval;
+        energy += rest / SIM_REPORT_PJ_IN_NWH;
+        rest %= SIM_REPORT_PJ_IN_NWH;
+
+        energy_float += power_float * interval_float / 60.0f / 60.0f;
+    }
+
+    exact = ((double)data.power * (double)interval * (double)steps) / (double)SIM_REPORT_PJ_IN_NWH;
+
+    (void)fprintf(stream, "Accumulation over %u days (CH%u, %.3f mW every %.3f ms): exact %.3f Wh\n",
+                  SIM_REPORT_DRIFT_DAYS, channel, data.power / 1000.0, (double)interval / 1000.0, exact / 1e9);
+    Sim_Report_PrintError(stream, "Integer", "nWh", (double)energy, exact);
+    Sim_Report_PrintError(stream, "Float", "nWh", (double)energy_float * 1e6, exact);
+}
+
+/*!
+ * \brief Print measured value against the true one
+ *
+ * \param[in] stream Output stream
+ * \param[in] name Quantity
+ * \param[in] unit Unit of the values
+ * \param[in] measured Value accumulated by the HAL
+ * \param[in] expected Integral of the load profile
+ *
+ * \retval None
+ */
+static void Sim_Report_PrintError(FILE* stream, const char* name, const char* unit, double measured, double expected)
+{
+    (void)fprintf(stream, "  %s: measured %.1f %s, true %.1f %s, error ", name, measured, unit, expected, unit);
+
+    if(expected != 0.0)
+    {
+        (void)fprintf(stream, "%+.3f %%\n", ((measured - expected) * 100.0) / expected);
+    }
+    else
+    {
+        (void)fprintf(stream, "%+.1f %s\n", measured - expected, unit);
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef _SIM_REPORT_H_
+#define _SIM_REPORT_H_
+
+/*
+ * Measurement report of the host simulation - energy and charge accumulated by the HAL compared to the
+ * exact integral of the load profiles, and the achieved sample rate, for the firmware configuration the
+ * simulation was built with. The comparison starts at the first sample of every channel, so the energy
+ * must not be reset from the command interface meanwhile.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdio.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_Report_Init(void);
+void Sim_Report_Print(FILE* stream);
+
+#endif  /* _SIM_REPORT_H_ */
@@ -0,0 +1,252 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "usart.h"
+#include "sim_uart.h"
+#include "sim_os.h"
+#include "sim_cfg.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_UART_RX_CHUNK_LEN       (64U)   /* Bytes read from stdin at once - received back-to-back */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static void* Sim_Uart_TxThread(void* arg);
+static void* Sim_Uart_RxThread(void* arg);
+static uint64_t Sim_Uart_TransferTime(uint32_t size);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+USART_TypeDef Sim_Usart3;
+UART_HandleTypeDef huart3 = {.Instance = USART3, .gState = HAL_UART_STATE_READY};
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/* Transmission */
+static pthread_mutex_t Sim_Uart_TxMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t Sim_Uart_TxCond;
+static const uint8_t* Sim_Uart_TxData;
+static uint16_t Sim_Uart_TxSize;
+static uint64_t Sim_Uart_TxStart;   /* Start of the transfer in ns */
+static bool Sim_Uart_TxPending;     /* Transfer waits for the transmit thread */
+static bool Sim_Uart_TxBusy;        /* Transfer started and not completed */
+
+/* Reception - accessed in simulated interrupts only */
+static uint8_t* Sim_Uart_RxData;
+static uint16_t Sim_Uart_RxSize;
+static uint16_t Sim_Uart_RxPos;     /* Next DMA write position */
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Simulated UART initialization function
+ *
+ * \param[in] None
+ *
+ * \retval None
+ */
+void Sim_Uart_Init(void)
+{
+    Sim_Os_CondInit(&Sim_Uart_TxCond);
+
+    (void)Sim_Os_CreateIrqThread("Sim_UartTx", Sim_Uart_TxThread, SIM_UART_NVIC_PRIORITY);
+    (void)Sim_Os_CreateIrqThread("Sim_UartRx", Sim_Uart_RxThread, SIM_UART_NVIC_PRIORITY);
+}
+
+/*!
+ * \brief Start DMA transmission
+ *
+ * \param[in] huart UART handle
+ * \param[in] pData Transmitted data - has to stay valid until the complete callback
+ * \param[in] Size Number of bytes
+ *
+ * \retval HAL_OK - started, HAL_BUSY - transfer in progress
+ */
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+    HAL_StatusTypeDef ret_val = HAL_BUSY;
+
+    (void)pthread_mutex_lock(&Sim_Uart_TxMutex);
+
+    if(Sim_Uart_TxBusy == false)
+    {
+        Sim_Uart_TxData = pData;
+        Sim_Uart_TxSize = Size;
+        Sim_Uart_TxStart = Sim_Os_GetTimeNs();
+        Sim_Uart_TxBusy = true;
+        Sim_Uart_TxPending = true;
+        huart->gState = HAL_UART_STATE_BUSY_TX;
+        (void)pthread_cond_signal(&Sim_Uart_TxCond);
+        ret_val = HAL_OK;
+    }
+
+    (void)pthread_mutex_unlock(&Sim_Uart_TxMutex);
+
+    return ret_val;
+}
+
+/*!
+ * \brief Start circular DMA reception with idle line detection
+ *
+ * \param[in] huart UART handle
+ * \param[out] pData Circular reception buffer
+ * \param[in] Size Buffer size
+ *
+ * \retval HAL_OK
+ */
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+    Sim_Os_IrqEnter();
+    Sim_Uart_RxData = pData;
+    Sim_Uart_RxSize = Size;
+    Sim_Uart_RxPos = 0U;
+    huart->ErrorCode = HAL_UART_ERROR_NONE;
+    Sim_Os_IrqExit();
+
+    return HAL_OK;
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Transmit thread - writes the transfer to stdout after the transfer time and runs the complete
+ *        callback as a simulated interrupt
+ *
+ * \param[in] arg Not used
+ *
+ * \retval NULL
+ */
+static void* Sim_Uart_TxThread(void* arg)
+{
+    const uint8_t* data;
+    uint16_t size;
+    uint64_t start;
+
+    for(;;)
+    {
+        (void)pthread_mutex_lock(&Sim_Uart_TxMutex);
+
+        while(Sim_Uart_TxPending == false)
+        {
+            (void)pthread_cond_wait(&Sim_Uart_TxCond, &Sim_Uart_TxMutex);
+        }
+
+        data = Sim_Uart_TxData;
+        size = Sim_Uart_TxSize;
+        start = Sim_Uart_TxStart;
+        Sim_Uart_TxPending = false;
+        (void)pthread_mutex_unlock(&Sim_Uart_TxMutex);
+
+        Sim_Os_SleepUntil(start + Sim_Uart_TransferTime(size));
+
+        (void)fwrite(data, 1U, size, stdout);
+        (void)fflush(stdout);
+
+        Sim_Os_IrqEnter();
+
+        /* The callback starts the next chunk */
+        (void)pthread_mutex_lock(&Sim_Uart_TxMutex);
+        Sim_Uart_TxBusy = false;
+        huart3.gState = HAL_UART_STATE_READY;
+        (void)pthread_mutex_unlock(&Sim_Uart_TxMutex);
+
+        HAL_UART_TxCpltCallback(&huart3);
+
+        Sim_Os_IrqExit();
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Receive thread - stores stdin bytes into the DMA buffer and reports the half, full and idle
+ *        line events as a simulated interrupt. Bytes received while no reception runs are lost.
+ *
+ * \param[in] arg Not used
+ *
+ * \retval NULL
+ */
+static void* Sim_Uart_RxThread(void* arg)
+{
+    uint8_t chunk[SIM_UART_RX_CHUNK_LEN];
+    ssize_t len;
+    uint64_t start;
+
+    for(;;)
+    {
+        len = read(STDIN_FILENO, chunk, sizeof(chunk));
+
+        if(len <= 0)
+        {
+            /* End of input - the line stays idle */
+            break;
+        }
+
+        start = Sim_Os_GetTimeNs();
+        Sim_Os_SleepUntil(start + Sim_Uart_TransferTime((uint32_t)len));
+
+        Sim_Os_IrqEnter();
+
+        if(Sim_Uart_RxData != NULL)
+        {
+            for(ssize_t i = 0; i < len; i++)
+            {
+                Sim_Uart_RxData[Sim_Uart_RxPos] = chunk[i];
+                Sim_Uart_RxPos++;
+
+                if(Sim_Uart_RxPos == (Sim_Uart_RxSize / 2U))
+                {
+                    HAL_UARTEx_RxEventCallback(&huart3, Sim_Uart_RxPos);
+                }
+                else if(Sim_Uart_RxPos == Sim_Uart_RxSize)
+                {
+                    HAL_UARTEx_RxEventCallback(&huart3, Sim_Uart_RxSize);
+                    Sim_Uart_RxPos = 0U;
+                }
+            }
+
+            /* Idle line after the chunk */
+            if(Sim_Uart_RxPos != 0U)
+            {
+                HAL_UARTEx_RxEventCallback(&huart3, Sim_Uart_RxPos);
+            }
+        }
+
+        Sim_Os_IrqExit();
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Time on the wire
+ *
+ * \param[in] size Number of bytes
+ *
+ * \retval Time in ns
+ */
+static uint64_t Sim_Uart_TransferTime(uint32_t size)
+{
+    return ((uint64_t)size * SIM_UART_FRAME_BITS * SIM_OS_NS_IN_S) / SIM_UART_BAUD_RATE;
+}
@@ -0,0 +1,35 @@
+#ifndef _SIM_UART_H_
+#define _SIM_UART_H_
+
+/*
+ * Simulated USART3 with DMA - the transmitted bytes are written to stdout after the transfer time at
+ * the baud rate, bytes read from stdin are received into the circular DMA buffer. The HAL callbacks
+ * are called as from the DMA and idle line interrupts.
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_Uart_Init(void);
+
+#endif  /* _SIM_UART_H_ */
@@ -0,0 +1,343 @@
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_waveform.h"
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+#define SIM_WAVEFORM_NS_IN_US       (1000.0)
+#define SIM_WAVEFORM_LINE_LEN       (256U)
+#define SIM_WAVEFORM_RECORD_LEN     (12U)       /* Binary record - 3 x 32 bits */
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ **************************************** Local function prototypes ****************************************
+ ***********************************************************************************************************/
+
+static uint8_t Sim_Waveform_Add(Sim_Waveform_t* waveform, double time, double bus_voltage, double current);
+static uint8_t Sim_Waveform_LoadCsv(Sim_Waveform_t* waveform, FILE* file);
+static uint8_t Sim_Waveform_LoadBinary(Sim_Waveform_t* waveform, FILE* file);
+static uint32_t Sim_Waveform_Find(const Sim_Waveform_t* waveform, uint64_t time);
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ********************************************* Local objects ***********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ******************************************* Exported functions ********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Set constant profile
+ *
+ * \param[out] waveform Profile
+ * \param[in] bus_voltage Bus voltage in uV
+ * \param[in] current Load current in uA
+ *
+ * \retval None
+ */
+void Sim_Waveform_Constant(Sim_Waveform_t* waveform, int32_t bus_voltage, int32_t current)
+{
+    waveform->points = NULL;
+    waveform->num = 0U;
+    waveform->period = 0U;
+    (void)Sim_Waveform_Add(waveform, 0.0, bus_voltage, current);
+}
+
+/*!
+ * \brief Load profile from a CSV or binary file - the time of the first point becomes 0
+ *
+ * \param[out] waveform Profile
+ * \param[in] path File path, *.csv is read as text
+ *
+ * \retval Status code
+ */
+uint8_t Sim_Waveform_Load(Sim_Waveform_t* waveform, const char* path)
+{
+    const char* extension = strrchr(path, '.');
+    FILE* file = fopen(path, (extension != NULL) && (strcmp(extension, ".csv") == 0) ? "r" : "rb");
+    uint8_t ret_val;
+    uint64_t first;
+
+    if(file == NULL)
+    {
+        return SIM_WAVEFORM_CODE_NOT_OK;
+    }
+
+    waveform->points = NULL;
+    waveform->num = 0U;
+    waveform->period = 0U;
+
+    if((extension != NULL) && (strcmp(extension, ".csv") == 0))
+    {
+        ret_val = Sim_Waveform_LoadCsv(waveform, file);
+    }
+    else
+    {
+        ret_val = Sim_Waveform_LoadBinary(waveform, file);
+    }
+
+    (void)fclose(file);
+
+    if((ret_val != SIM_WAVEFORM_CODE_OK) || (waveform->num == 0U))
+    {
+        free(waveform->points);
+        waveform->points = NULL;
+        waveform->num = 0U;
+        return SIM_WAVEFORM_CODE_NOT_OK;
+    }
+
+    first = waveform->points[0].time;
+
+    for(uint32_t i = 0U; i < waveform->num; i++)
+    {
+        waveform->points[i].time -= first;
+    }
+
+    /* One point is a constant profile, otherwise the last point closes the period */
+    if(waveform->num > 1U)
+    {
+        waveform->period = waveform->points[waveform->num - 1U].time;
+
+        if(waveform->period == 0U)
+        {
+            return SIM_WAVEFORM_CODE_NOT_OK;
+        }
+    }
+
+    return SIM_WAVEFORM_CODE_OK;
+}
+
+/*!
+ * \brief Integrate bus voltage, current and power over the interval
+ *
+ * \param[in] waveform Profile
+ * \param[in] start Start of the interval in ns
+ * \param[in] end End of the interval in ns
+ * \param[out] integral Integrals - uV*ns, uA*ns and uV*uA*ns
+ *
+ * \retval None
+ */
+void Sim_Waveform_Integrate(const Sim_Waveform_t* waveform, uint64_t start, uint64_t end, Sim_Waveform_Integral_t* integral)
+{
+    const Sim_Waveform_Point_t* point;
+    uint64_t cycle;
+    uint64_t segment_end;
+    uint64_t time = start;
+    uint32_t index;
+    double duration;
+
+    integral->bus_voltage = 0.0;
+    integral->current = 0.0;
+    integral->power = 0.0;
+
+    if(end <= start)
+    {
+        return;
+    }
+
+    if(waveform->period == 0U)
+    {
+        duration = (double)(end - start);
+        integral->bus_voltage = (double)waveform->points[0].bus_voltage * duration;
+        integral->current = (double)waveform->points[0].current * duration;
+        integral->power = (double)waveform->points[0].bus_voltage * (double)waveform->points[0].current * duration;
+        return;
+    }
+
+    cycle = start / waveform->period;
+    index = Sim_Waveform_Find(waveform, start % waveform->period);
+
+    while(time < end)
+    {
+        point = &waveform->points[index];
+        segment_end = (cycle * waveform->period) + waveform->points[index + 1U].time;
+
+        if(segment_end > end)
+        {
+            segment_end = end;
+        }
+
+        duration = (double)(segment_end - time);
+        integral->bus_voltage += (double)point->bus_voltage * duration;
+        integral->current += (double)point->current * duration;
+        integral->power += (double)point->bus_voltage * (double)point->current * duration;
+
+        time = segment_end;
+        index++;
+
+        if(index == (waveform->num - 1U))
+        {
+            index = 0U;
+            cycle++;
+        }
+    }
+}
+
+/***********************************************************************************************************
+ ******************************************** Local functions **********************************************
+ ***********************************************************************************************************/
+
+/*!
+ * \brief Append point
+ *
+ * \param[in,out] waveform Profile
+ * \param[in] time Time in us
+ * \param[in] bus_voltage Bus voltage in uV
+ * \param[in] current Load current in uA
+ *
+ * \retval Status code
+ */
+static uint8_t Sim_Waveform_Add(Sim_Waveform_t* waveform, double time, double bus_voltage, double current)
+{
+    Sim_Waveform_Point_t* points = realloc(waveform->points, (waveform->num + 1U) * sizeof(Sim_Waveform_Point_t));
+    Sim_Waveform_Point_t* point;
+
+    if(points == NULL)
+    {
+        return SIM_WAVEFORM_CODE_NOT_OK;
+    }
+
+    waveform->points = points;
+    point = &points[waveform->num];
+    point->time = (uint64_t)(time * SIM_WAVEFORM_NS_IN_US);
+    point->bus_voltage = (int32_t)bus_voltage;
+    point->current = (int32_t)current;
+
+    /* Time has to be monotonic */
+    if((waveform->num > 0U) && (point->time < points[waveform->num - 1U].time))
+    {
+        return SIM_WAVEFORM_CODE_NOT_OK;
+    }
+
+    waveform->num++;
+
+    return SIM_WAVEFORM_CODE_OK;
+}
+
+/*!
+ * \brief Read CSV rows - time, bus voltage and current separated by comma, semicolon or spaces
+ *
+ * \param[in,out] waveform Profile
+ * \param[in] file Opened file
+ *
+ * \retval Status code
+ */
+static uint8_t Sim_Waveform_LoadCsv(Sim_Waveform_t* waveform, FILE* file)
+{
+    char line[SIM_WAVEFORM_LINE_LEN];
+    double value[3];
+    char* pos;
+    char* end;
+    uint32_t i;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        pos = line;
+
+        while(isspace((unsigned char)*pos))
+        {
+            pos++;
+        }
+
+        /* Header or comment */
+        if((isdigit((unsigned char)*pos) == 0) && (*pos != '-') && (*pos != '+') && (*pos != '.'))
+        {
+            continue;
+        }
+
+        for(i = 0U; i < 3U; i++)
+        {
+            value[i] = strtod(pos, &end);
+
+            if(end == pos)
+            {
+                return SIM_WAVEFORM_CODE_NOT_OK;
+            }
+
+            pos = end + strspn(end, ",; \t");
+        }
+
+        if(Sim_Waveform_Add(waveform, value[0], value[1], value[2]) != SIM_WAVEFORM_CODE_OK)
+        {
+            return SIM_WAVEFORM_CODE_NOT_OK;
+        }
+    }
+
+    return SIM_WAVEFORM_CODE_OK;
+}
+
+/*!
+ * \brief Read binary records
+ *
+ * \param[in,out] waveform Profile
+ * \param[in] file Opened file
+ *
+ * \retval Status code
+ */
+static uint8_t Sim_Waveform_LoadBinary(Sim_Waveform_t* waveform, FILE* file)
+{
+    uint8_t record[SIM_WAVEFORM_RECORD_LEN];
+    uint32_t value[3];
+
+    while(fread(record, 1U, sizeof(record), file) == sizeof(record))
+    {
+        for(uint32_t i = 0U; i < 3U; i++)
+        {
+            value[i] = (uint32_t)record[4U * i] | ((uint32_t)record[(4U * i) + 1U] << 8U) |
+                       ((uint32_t)record[(4U * i) + 2U] << 16U) | ((uint32_t)record[(4U * i) + 3U] << 24U);
+        }
+
+        if(Sim_Waveform_Add(waveform, value[0], (int32_t)value[1], (int32_t)value[2]) != SIM_WAVEFORM_CODE_OK)
+        {
+            return SIM_WAVEFORM_CODE_NOT_OK;
+        }
+    }
+
+    return SIM_WAVEFORM_CODE_OK;
+}
+
+/*!
+ * \brief Find the point which holds at the time
+ *
+ * \param[in] waveform Periodic profile
+ * \param[in] time Time within the period in ns
+ *
+ * \retval Index of the last point not after the time, the closing point is never returned
+ */
+static uint32_t Sim_Waveform_Find(const Sim_Waveform_t* waveform, uint64_t time)
+{
+    uint32_t low = 0U;
+    uint32_t high = waveform->num - 2U;
+    uint32_t middle;
+
+    while(low < high)
+    {
+        middle = (low + high + 1U) / 2U;
+
+        if(waveform->points[middle].time <= time)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1U;
+        }
+    }
+
+    return low;
+}
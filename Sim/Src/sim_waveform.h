@@ -0,0 +1,71 @@
+#ifndef _SIM_WAVEFORM_H_
+#define _SIM_WAVEFORM_H_
+
+/*
+ * Load profile of a simulated INA226 - bus voltage and load current over time. The values hold until
+ * the next point (sample-and-hold, exact for PWM edges) and the profile repeats with the time of the
+ * last point, which only closes the period.
+ *
+ * File formats, one point per row/record in uV, uA and us:
+ *   *.csv - "time_us,bus_voltage_uv,current_ua", rows not starting with a number are skipped
+ *   other - packed little-endian records {uint32_t time_us; int32_t bus_voltage_uv; int32_t current_ua;}
+ */
+
+/***********************************************************************************************************
+ ********************************************* Included files **********************************************
+ ***********************************************************************************************************/
+
+#include <stdint.h>
+
+/***********************************************************************************************************
+ ************************************************* Defines *************************************************
+ ***********************************************************************************************************/
+
+/*
+ * Status codes
+ */
+#define SIM_WAVEFORM_CODE_OK        (0U)
+#define SIM_WAVEFORM_CODE_NOT_OK    (1U)
+
+/***********************************************************************************************************
+ *********************************************** Data types ************************************************
+ ***********************************************************************************************************/
+
+typedef struct
+{
+    uint64_t time;                  /* ns from the start of the period */
+    int32_t bus_voltage;            /* uV */
+    int32_t current;                /* uA */
+}Sim_Waveform_Point_t;
+
+typedef struct
+{
+    Sim_Waveform_Point_t* points;
+    uint32_t num;
+    uint64_t period;                /* ns, 0 - constant */
+}Sim_Waveform_t;
+
+/* Integrals over an interval */
+typedef struct
+{
+    double bus_voltage;             /* uV * ns */
+    double current;                 /* uA * ns */
+    double power;                   /* uW * ns */
+}Sim_Waveform_Integral_t;
+
+/***********************************************************************************************************
+ ******************************************** Exported objects *********************************************
+ ***********************************************************************************************************/
+
+/***********************************************************************************************************
+ ************************************** Exported function prototypes ***************************************
+ ***********************************************************************************************************/
+
+/*
+ * API
+ */
+void Sim_Waveform_Constant(Sim_Waveform_t* waveform, int32_t bus_voltage, int32_t current);
+uint8_t Sim_Waveform_Load(Sim_Waveform_t* waveform, const char* path);
+void Sim_Waveform_Integrate(const Sim_Waveform_t* waveform, uint64_t start, uint64_t end, Sim_Waveform_Integral_t* integral);
+
+#endif  /* _SIM_WAVEFORM_H_ */
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""Compare two runs of the benchmark build (energy_monitor_bench) and flag regressions.
+
+Reads the BENCH lines from UART captures - the regular log around them is skipped, the last
+complete report of each capture is used. Line format: 1_APP/Bench/Src/app_bench.h
+
+    bench_compare.py baseline.txt current.txt                 # median slower by more than 5 %
+    bench_compare.py baseline.txt current.txt --threshold 2 --min-cycles 20
+
+The rate column is the number of calls per second at the clock of the current run (median) - lines
+per second for app_format_line and snprintf_line, records per second for telemetry_record, samples
+per second for telemetry_stream_add and blocks per second for telemetry_stream_end.
+
+Exit status 1 if any benchmark regressed or is missing in the current run.
+"""
+
+import argparse
+import sys
+
+
+def read_report(path):
+    """Return (header, {name: (samples, min, median, max)}) of the last complete report."""
+    with open(path, "rb") as capture:
+        lines = capture.read().decode("latin-1").splitlines()
+    report = None
+    current = None
+    for line in lines:
+        # Binary log formats may precede a line on the same "line"
+        pos = line.find("BENCH")
+        if pos < 0:
+            continue
+        fields = line[pos:].strip().split(",")
+        try:
+            if fields[0] == "BENCH_BEGIN":
+                current = ({"clock": int(fields[1]), "warmup": int(fields[2]), "repetitions": int(fields[3])}, {})
+            elif fields[0] == "BENCH" and current is not None:
+                current[1][fields[1]] = tuple(int(value) for value in fields[2:6])
+            elif fields[0] == "BENCH_END" and current is not None:
+                report = current
+                current = None
+        except (IndexError, ValueError):
+            print("# %s: malformed line %r" % (path, line[pos:]), file=sys.stderr)
+    if report is None:
+        raise SystemExit("%s: no complete benchmark report" % path)
+    return report
+
+
+def rate_text(clock, result):
+    """Calls per second of one benchmark from its median cycles."""
+    if result[0] == 0 or result[2] == 0:
+        return "-"
+    return "%.0f" % (clock / result[2])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="capture of the reference run")
+    parser.add_argument("current", help="capture of the run to check")
+    parser.add_argument("--threshold", type=float, default=5.0, help="allowed median increase in %% (default 5)")
+    parser.add_argument("--min-cycles", type=int, default=10,
+                        help="smaller median increases are noise (default 10 cycles)")
+    args = parser.parse_args()
+
+    base_header, base = read_report(args.baseline)
+    curr_header, curr = read_report(args.current)
+    if base_header != curr_header:
+        print("# configurations differ: %s vs %s" % (base_header, curr_header), file=sys.stderr)
+
+    failed = False
+    print("%-24s %10s %10s %8s %12s  %s" % ("benchmark", "baseline", "current", "change", "rate [1/s]", "status"))
+    for name in list(base) + [name for name in curr if name not in base]:
+        if name not in curr:
+            print("%-24s %10d %10s %8s %12s  %s" % (name, base[name][2], "-", "-", "-", "MISSING"))
+            failed = True
+            continue
+        rate = rate_text(curr_header["clock"], curr[name])
+        if name not in base:
+            print("%-24s %10s %10d %8s %12s  %s" % (name, "-", curr[name][2], "-", rate, "new"))
+            continue
+        if base[name][0] == 0 or curr[name][0] == 0:
+            print("%-24s %10d %10d %8s %12s  %s" % (name, base[name][2], curr[name][2], "-", rate, "no samples"))
+            continue
+        old = base[name][2]
+        new = curr[name][2]
+        change = ((new - old) * 100.0 / old) if old else 0.0
+        status = "ok"
+        if new - old > args.min_cycles and change > args.threshold:
+            status = "REGRESSION"
+            failed = True
+        elif old - new > args.min_cycles and -change > args.threshold:
+            status = "improved"
+        print("%-24s %10d %10d %+7.1f%% %12s  %s" % (name, old, new, change, rate, status))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
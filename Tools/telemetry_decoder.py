@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""Decoder of the binary energy monitor log (APP_ENERGY_MONITOR_LOG_FORMAT = 1 or 2, or the "format" command).
+
+Reads COBS framed records or compressed stream blocks from a serial port or a file and prints
+the samples as CSV. Task statistics records go to stderr as "# task" lines, framed log lines
+as they are. Frame layouts: 1_APP/Telemetry/Src/app_telemetry.h
+
+    telemetry_decoder.py /dev/ttyACM0            # serial port, 115200 baud
+    telemetry_decoder.py capture.bin             # raw capture
+"""
+
+import argparse
+import struct
+import sys
+
+RECORD = struct.Struct("<BHIiiiH")
+TYPE_RECORD = 1
+TYPE_STREAM = 2
+TASK = struct.Struct("<BHIHH16sH")
+TYPE_TASK = 3
+TYPE_TRACE = 4
+TYPE_TEXT = 5
+
+
+def crc16_ccitt_false(data):
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    data = bytearray()
+    pos = 0
+    while pos < len(frame):
+        code = frame[pos]
+        if code == 0 or pos + code > len(frame) + 1:
+            raise ValueError("invalid COBS code")
+        data += frame[pos + 1:pos + code]
+        pos += code
+        if code < 0xFF and pos < len(frame):
+            data.append(0)
+    return bytes(data)
+
+
+def read_varint(data, pos):
+    """Zig-zag LEB128 varint, returns (value, next position)."""
+    result = 0
+    shift = 0
+    while True:
+        if pos >= len(data) or shift > 28:
+            raise ValueError("truncated varint")
+        byte = data[pos]
+        pos += 1
+        result |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            break
+    return (result >> 1) ^ -(result & 1), pos
+
+
+def int32(value):
+    return ((value + 0x80000000) & 0xFFFFFFFF) - 0x80000000
+
+
+def decode_record(record):
+    if len(record) != RECORD.size:
+        raise ValueError("invalid record length %d" % len(record))
+    header, sequence, time_us, voltage, current, power, _ = RECORD.unpack(record)
+    return [{
+        "channel": header & 0x0F,
+        "alert": (header >> 4) & 0x01,
+        "sequence": sequence,
+        "time_us": time_us,
+        "voltage_uv": voltage,
+        "current_ua": current,
+        "power_uw": power,
+    }]
+
+
+def decode_task(record):
+    if len(record) != TASK.size:
+        raise ValueError("invalid task record length %d" % len(record))
+    header, sequence, time_us, load, stack, name, _ = TASK.unpack(record)
+    return [{
+        "index": header & 0x0F,
+        "sequence": sequence,
+        "time_us": time_us,
+        "load": load / 100.0,
+        "stack_words": stack,
+        "name": name.split(b"\0", 1)[0].decode("ascii", "replace"),
+    }]
+
+
+def decode_stream(block):
+    """Block is decoded on its own - the first entry of each channel is a keyframe."""
+    (sequence, lost) = struct.unpack_from("<HH", block, 1)
+    if lost:
+        print("# %d samples lost before block %d" % (lost, sequence), file=sys.stderr)
+    state = {}
+    samples = []
+    pos = 5
+    end = len(block) - 2
+    while pos < end:
+        tag = block[pos]
+        pos += 1
+        channel = tag & 0x0F
+        if tag & 0x10:
+            (time_us,) = struct.unpack_from("<I", block, pos)
+            pos += 4
+            voltage, pos = read_varint(block, pos)
+            current, pos = read_varint(block, pos)
+            power, pos = read_varint(block, pos)
+            step = 0
+        else:
+            if channel not in state:
+                raise ValueError("delta without keyframe")
+            time_us, step, voltage, current, power = state[channel]
+            d_step, pos = read_varint(block, pos)
+            d_voltage, pos = read_varint(block, pos)
+            d_current, pos = read_varint(block, pos)
+            d_power, pos = read_varint(block, pos)
+            step = int32(step + d_step)
+            time_us = (time_us + step) & 0xFFFFFFFF
+            voltage = int32(voltage + d_voltage)
+            current = int32(current + d_current)
+            power = int32(power + d_power)
+        state[channel] = (time_us, step, voltage, current, power)
+        samples.append({
+            "channel": channel,
+            "alert": (tag >> 5) & 0x01,
+            "sequence": sequence,
+            "time_us": time_us,
+            "voltage_uv": voltage,
+            "current_ua": current,
+            "power_uw": power,
+        })
+    if pos != end:
+        raise ValueError("entry crosses the CRC")
+    return samples
+
+
+def decode_frame(frame):
+    data = cobs_decode(frame)
+    if len(data) < 3:
+        raise ValueError("frame too short")
+    if struct.unpack_from("<H", data, len(data) - 2)[0] != crc16_ccitt_false(data[:-2]):
+        raise ValueError("CRC mismatch")
+    frame_type = data[0] >> 5
+    if frame_type == TYPE_RECORD:
+        return frame_type, decode_record(data)
+    if frame_type == TYPE_STREAM:
+        return frame_type, decode_stream(data)
+    if frame_type == TYPE_TASK:
+        return frame_type, decode_task(data)
+    if frame_type == TYPE_TRACE:
+        return frame_type, []  # trace dump - Tools/trace_to_perfetto.py
+    if frame_type == TYPE_TEXT:
+        return frame_type, [data[1:-2].decode("ascii", "replace").rstrip("\r\n")]
+    raise ValueError("unsupported frame type %d" % frame_type)
+
+
+def frames(stream):
+    """Yield frames split on the 0x00 delimiter, the first partial frame is dropped."""
+    buf = bytearray()
+    synced = False
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        for byte in chunk:
+            if byte == 0:
+                if synced and buf:
+                    yield bytes(buf)
+                buf.clear()
+                synced = True
+            else:
+                buf.append(byte)
+
+
+def open_input(path, baudrate):
+    if path == "-":
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+
+        return serial.Serial(path, baudrate, timeout=1)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial port, capture file or - for stdin")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    args = parser.parse_args()
+
+    print("channel,sequence,time_us,voltage_V,current_mA,power_mW,alert")
+    last_sequence = {}  # per frame type - records and blocks are numbered separately
+    last_type = None
+    errors = 0
+    for frame in frames(open_input(args.input, args.baudrate)):
+        try:
+            frame_type, samples = decode_frame(frame)
+        except ValueError as err:
+            errors += 1
+            print("# dropped frame: %s" % err, file=sys.stderr)
+            continue
+        if frame_type == TYPE_TRACE:
+            continue
+        if frame_type == TYPE_TEXT:
+            print(samples[0], file=sys.stderr)
+            continue
+        if frame_type == TYPE_TASK:
+            task = samples[0]
+            print("# task %d,%d,%s,%.2f%%,%d words" % (task["sequence"], task["time_us"], task["name"],
+                                                      task["load"], task["stack_words"]), file=sys.stderr)
+            continue
+        if frame_type != last_type:
+            # Format switched - the other format carried the samples in between
+            last_sequence.pop(frame_type, None)
+            last_type = frame_type
+        sequence = samples[0]["sequence"]
+        last = last_sequence.get(frame_type)
+        if last is not None and sequence != (last + 1) & 0xFFFF:
+            print("# %d %s lost" % ((sequence - last - 1) & 0xFFFF,
+                                    "records" if frame_type == TYPE_RECORD else "blocks"), file=sys.stderr)
+        last_sequence[frame_type] = sequence
+        for rec in samples:
+            print("%d,%d,%d,%.6f,%.3f,%.3f,%d" % (rec["channel"], rec["sequence"], rec["time_us"],
+                                                  rec["voltage_uv"] / 1e6, rec["current_ua"] / 1e3,
+                                                  rec["power_uw"] / 1e3, rec["alert"]))
+    if errors:
+        print("# %d invalid frames" % errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""Convert the trace dump of the "trace" command into Chrome trace / Perfetto JSON.
+
+Reads COBS framed telemetry from a serial port or a capture file - the periodic log around the dump
+is skipped, the last dump is used. Frame layout: 1_APP/Telemetry/Src/app_telemetry.h (type 4)
+
+    trace_to_perfetto.py capture.bin -o trace.json          # open in ui.perfetto.dev or chrome://tracing
+    trace_to_perfetto.py /dev/ttyACM0 --send -o trace.json  # send the command and read the dump
+
+Every task and every interrupt handler or callback gets its own track. The summary on stderr lists
+the period jitter and the longest run of every task and interrupt, and which interrupt ran inside
+which - a HAL callback (lower case) inside its handler (vector name) is expected, a handler inside
+another handler was preempted by it.
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+
+from telemetry_decoder import cobs_decode, crc16_ccitt_false, frames, open_input
+
+TYPE_TRACE = 4
+KIND_INFO = 0
+KIND_NAME = 1
+KIND_EVENTS = 2
+NAME_TASK = 0
+NAME_ISR = 1
+
+EVENT_TASK_IN = 0
+EVENT_TASK_OUT = 1
+EVENT_ISR_ENTER = 2
+EVENT_ISR_EXIT = 3
+
+INFO = struct.Struct("<BIIIH")
+NAME = struct.Struct("<BBB16sH")
+EVENT = struct.Struct("<IBB")
+
+PID = 1
+TID_TASK = 1000     # + task number
+TID_ISR = 2000      # + interrupt id
+
+
+class Dump:
+    def __init__(self, clock, written, kept):
+        self.clock = clock
+        self.written = written
+        self.kept = kept
+        self.tasks = {}
+        self.isrs = {}
+        self.events = []
+        self.frames_lost = 0
+        self.sequence = 0
+
+
+def read_dump(stream):
+    """Return the last dump of the stream, None if there is none."""
+    dump = None
+    last = None
+    for frame in frames(stream):
+        try:
+            data = cobs_decode(frame)
+        except ValueError:
+            continue
+        if len(data) < 3 or (data[0] >> 5) != TYPE_TRACE:
+            continue
+        if struct.unpack_from("<H", data, len(data) - 2)[0] != crc16_ccitt_false(data[:-2]):
+            if dump is not None:
+                dump.frames_lost += 1
+            continue
+        kind = data[0] & 0x0F
+        if kind == KIND_INFO and len(data) == INFO.size:
+            _, clock, written, kept, _ = INFO.unpack(data)
+            dump = Dump(clock, written, kept)
+            last = dump
+        elif dump is None:
+            continue
+        elif kind == KIND_NAME and len(data) == NAME.size:
+            _, source, ident, name, _ = NAME.unpack(data)
+            name = name.split(b"\0", 1)[0].decode("ascii", "replace")
+            (dump.tasks if source == NAME_TASK else dump.isrs)[ident] = name
+        elif kind == KIND_EVENTS and (len(data) - 5) % EVENT.size == 0:
+            sequence = struct.unpack_from("<H", data, 1)[0]
+            dump.frames_lost += (sequence - dump.sequence) & 0xFFFF
+            dump.sequence = (sequence + 1) & 0xFFFF
+            for pos in range(3, len(data) - 2, EVENT.size):
+                dump.events.append(EVENT.unpack_from(data, pos))
+    return last
+
+
+def unwrap(events):
+    """Extend the 32-bit cycle counter - events are nearly ordered, gaps must stay below 2^31 cycles."""
+    result = []
+    prev_raw = None
+    now = 0
+    for timestamp, event, ident in events:
+        if prev_raw is not None:
+            delta = (timestamp - prev_raw) & 0xFFFFFFFF
+            now += delta - (1 << 32) if delta >= (1 << 31) else delta
+        prev_raw = timestamp
+        result.append((now, event, ident))
+    # A preempting writer takes a later slot with an earlier timestamp
+    result.sort(key=lambda item: item[0])
+    return result
+
+
+class Stats:
+    def __init__(self, name):
+        self.name = name
+        self.starts = []
+        self.runs = []
+
+    def line(self):
+        periods = [b - a for a, b in zip(self.starts, self.starts[1:])]
+        text = "%-18s n=%-6d run max %9.1f us" % (self.name, len(self.runs), max(self.runs, default=0.0))
+        if periods:
+            mean = sum(periods) / len(periods)
+            text += "  period %.1f us (min %.1f, max %.1f, jitter %.1f us)" % (mean, min(periods), max(periods),
+                                                                              max(periods) - min(periods))
+        return text
+
+
+def convert(dump):
+    scale = 1e6 / dump.clock
+    events = unwrap(dump.events)
+    start = events[0][0] if events else 0
+    trace = []
+    task_open = {}
+    isr_open = {}
+    isr_stack = []
+    preemptions = {}
+    stats = {}
+
+    def task_name(ident):
+        return dump.tasks.get(ident, "task %d" % ident)
+
+    def isr_name(ident):
+        return dump.isrs.get(ident, "irq %d" % ident)
+
+    for cycles, event, ident in events:
+        now = (cycles - start) * scale
+        if event == EVENT_TASK_IN:
+            task_open[ident] = now
+        elif event == EVENT_TASK_OUT and ident in task_open:
+            begin = task_open.pop(ident)
+            trace.append({"name": task_name(ident), "ph": "X", "pid": PID, "tid": TID_TASK + ident,
+                          "ts": begin, "dur": now - begin})
+            entry = stats.setdefault(("task", ident), Stats(task_name(ident)))
+            entry.starts.append(begin)
+            entry.runs.append(now - begin)
+        elif event == EVENT_ISR_ENTER:
+            if isr_stack:
+                pair = (isr_stack[-1], ident)
+                preemptions[pair] = preemptions.get(pair, 0) + 1
+            isr_stack.append(ident)
+            isr_open[ident] = now
+        elif event == EVENT_ISR_EXIT and ident in isr_open:
+            begin = isr_open.pop(ident)
+            if ident in isr_stack:
+                isr_stack.remove(ident)
+            trace.append({"name": isr_name(ident), "ph": "X", "pid": PID, "tid": TID_ISR + ident,
+                          "ts": begin, "dur": now - begin})
+            entry = stats.setdefault(("isr", ident), Stats(isr_name(ident)))
+            entry.starts.append(begin)
+            entry.runs.append(now - begin)
+
+    trace.append({"name": "process_name", "ph": "M", "pid": PID, "args": {"name": "energy_monitor"}})
+    for ident, name in dump.tasks.items():
+        trace.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": TID_TASK + ident,
+                      "args": {"name": "task %s" % name}})
+        trace.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": TID_TASK + ident,
+                      "args": {"sort_index": TID_TASK + ident}})
+    for ident, name in dump.isrs.items():
+        trace.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": TID_ISR + ident,
+                      "args": {"name": "irq %s" % name}})
+        trace.append({"name": "thread_sort_index", "ph": "M", "pid": PID, "tid": TID_ISR + ident,
+                      "args": {"sort_index": TID_ISR + ident}})
+
+    duration = (events[-1][0] - start) * scale if events else 0.0
+    print("# %d events over %.3f ms, %d recorded since start-up, %d frames lost" % (
+        len(events), duration / 1e3, dump.written, dump.frames_lost), file=sys.stderr)
+    for key in sorted(stats):
+        print("# %s %s" % (key[0], stats[key].line()), file=sys.stderr)
+    for (outer, inner), count in sorted(preemptions.items()):
+        print("# irq %s inside %s %d times" % (isr_name(inner), isr_name(outer), count), file=sys.stderr)
+
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+class Deadline:
+    """Stream wrapper which ends the reading after the given time - the serial port never ends."""
+
+    def __init__(self, stream, seconds):
+        self.stream = stream
+        self.end = time.monotonic() + seconds
+
+    def read(self, size):
+        while time.monotonic() < self.end:
+            data = self.stream.read(size)
+            if data:
+                return data
+        return b""
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="serial port, capture file or - for stdin")
+    parser.add_argument("-o", "--output", default="-", help="JSON file, stdout by default")
+    parser.add_argument("--baudrate", type=int, default=115200)
+    parser.add_argument("--send", action="store_true", help="send the trace command (serial port)")
+    parser.add_argument("--timeout", type=float, default=10.0, help="seconds to read a serial port")
+    args = parser.parse_args()
+
+    stream = open_input(args.input, args.baudrate)
+    if hasattr(stream, "write") and hasattr(stream, "baudrate"):
+        if args.send:
+            stream.write(b"trace\r\n")
+        stream = Deadline(stream, args.timeout)
+
+    dump = read_dump(stream)
+    if dump is None or not dump.events:
+        print("no trace dump found", file=sys.stderr)
+        sys.exit(1)
+
+    result = convert(dump)
+    if args.output == "-":
+        json.dump(result, sys.stdout)
+    else:
+        with open(args.output, "w") as output:
+            json.dump(result, output)
+
+
+if __name__ == "__main__":
+    main()